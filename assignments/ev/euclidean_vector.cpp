@@ -3,68 +3,122 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <utility>
 
+#include "assignments/ev/vector_kernels.h"
+
 /* exception helper */
-EuclideanVectorError euclideanDimensionError(const EuclideanVector& X, const EuclideanVector& Y) {
+EuclideanVectorError euclideanDimensionError(int lhs, int rhs) {
   return EuclideanVectorError(static_cast<std::string>("Dimensions of LHS(") +
-                              std::to_string(X.GetNumDimensions()) + ") and RHS(" +
-                              std::to_string(Y.GetNumDimensions()) + ") do not match");
+                              std::to_string(lhs) + ") and RHS(" + std::to_string(rhs) +
+                              ") do not match");
 }
 
-/* constructors */
-EuclideanVector::EuclideanVector(int siz) noexcept
-  : size_(siz), magnitudes_(std::make_unique<double[]>(siz)) {
-  for (int i = 0; i < siz; i++) {
-    magnitudes_[i];
+/* expression evaluation */
+void EvaluateSum(double* dst, const double* a, const double* b, std::size_t n) {
+  // a + b is b + a exactly, so when dst is b it can take a instead
+  if (dst == b) {
+    Kernels().add(dst, a, n);
+    return;
+  }
+  if (dst != a) {
+    std::copy_n(a, n, dst);
+  }
+  Kernels().add(dst, b, n);
+}
+
+void EvaluateDifference(double* dst, const double* a, const double* b, std::size_t n) {
+  if (dst == b && dst != a) {
+    for (std::size_t i = 0; i < n; i++) {
+      dst[i] = a[i] - dst[i];
+    }
+    return;
+  }
+  if (dst != a) {
+    std::copy_n(a, n, dst);
   }
+  Kernels().subtract(dst, b, n);
 }
 
-EuclideanVector::EuclideanVector(int siz, double mag) noexcept
-  : size_(siz), magnitudes_(std::make_unique<double[]>(siz)) {
+void EvaluateProduct(double* dst, const double* a, double factor, std::size_t n) {
+  if (dst != a) {
+    std::copy_n(a, n, dst);
+  }
+  Kernels().scale(dst, factor, n);
+}
+
+void EvaluateQuotient(double* dst, const double* a, double divisor, std::size_t n) {
+  if (dst != a) {
+    std::copy_n(a, n, dst);
+  }
+  Kernels().divide(dst, divisor, n);
+}
+
+/* constructors */
+EuclideanVector::EuclideanVector(int siz, const allocator_type& alloc)
+  : resource_(alloc.resource()) {
+  Allocate(siz);
+  std::fill_n(magnitudes_, size_, 0.0);
+}
+
+EuclideanVector::EuclideanVector(int siz, double mag, const allocator_type& alloc)
+  : resource_(alloc.resource()) {
+  Allocate(siz);
   for (int i = 0; i < siz; i++) {
     magnitudes_[i] = mag;
   }
 }
 
 EuclideanVector::EuclideanVector(std::vector<double>::const_iterator beg,
-                                 std::vector<double>::const_iterator end) noexcept
-  : size_(std::distance(beg, end)), magnitudes_(std::make_unique<double[]>(end - beg)) {
+                                 std::vector<double>::const_iterator end,
+                                 const allocator_type& alloc)
+  : resource_(alloc.resource()) {
+  Allocate(std::distance(beg, end));
   int i = 0;
   for (auto it = beg; it != end; it++) {
     magnitudes_[i++] = *it;
   }
 }
 
-EuclideanVector::EuclideanVector(const EuclideanVector& oth) noexcept
-  : size_(oth.size_), magnitudes_(std::make_unique<double[]>(size_)) {
-  for (int i = 0; i < size_; i++) {
-    magnitudes_[i] = oth[i];
-  }
+EuclideanVector::EuclideanVector(const EuclideanVector& oth)
+  : EuclideanVector(oth, allocator_type{}) {}
+
+EuclideanVector::EuclideanVector(const EuclideanVector& oth,
+                                 const allocator_type& alloc)
+  : resource_(alloc.resource()) {
+  Allocate(oth.size_);
+  std::copy_n(oth.magnitudes_, size_, magnitudes_);
 }
 
-EuclideanVector::EuclideanVector(EuclideanVector&& oth) noexcept
-  : size_(oth.size_), magnitudes_(std::move(oth.magnitudes_)) {
-  oth.size_ = 0;
+EuclideanVector::EuclideanVector(EuclideanVector&& oth) noexcept : resource_(oth.resource_) {
+  StealFrom(oth);
 }
 
-/* enemies */
-EuclideanVector& EuclideanVector::operator=(const EuclideanVector& oth) noexcept {
-  size_ = oth.size_;
-  magnitudes_ = std::make_unique<double[]>(size_);
+EuclideanVector::~EuclideanVector() noexcept {
+  Release();
+}
 
-  for (int i = 0; i < size_; i++) {
-    magnitudes_[i] = oth[i];
+/* enemies */
+EuclideanVector& EuclideanVector::operator=(const EuclideanVector& oth) {
+  if (this == &oth) {
+    return *this;
+  }
+  // keep the buffer we have when it is already the right size
+  if (size_ != oth.size_) {
+    Allocate(oth.size_);
   }
+  std::copy_n(oth.magnitudes_, size_, magnitudes_);
 
   return *this;
 }
 
-EuclideanVector& EuclideanVector::operator=(EuclideanVector&& oth) noexcept {
-  size_ = oth.size_;
-  magnitudes_ = std::move(oth.magnitudes_);
+EuclideanVector& EuclideanVector::operator=(EuclideanVector&& oth) {
+  if (this != &oth) {
+    StealFrom(oth);
+  }
   return *this;
 }
 
@@ -80,28 +134,22 @@ double EuclideanVector::operator[](unsigned i) const noexcept {
 
 EuclideanVector& EuclideanVector::operator+=(const EuclideanVector& oth) {
   if (size_ != oth.size_) {
-    throw euclideanDimensionError(*this, oth);
-  }
-  for (int i = 0; i < size_; i++) {
-    magnitudes_[i] += oth[i];
+    throw euclideanDimensionError(size_, oth.size_);
   }
+  Kernels().add(magnitudes_, oth.magnitudes_, Length());
   return *this;
 }
 
 EuclideanVector& EuclideanVector::operator-=(const EuclideanVector& oth) {
   if (this->size_ != oth.size_) {
-    throw euclideanDimensionError(*this, oth);
-  }
-  for (int i = 0; i < size_; i++) {
-    magnitudes_[i] -= oth[i];
+    throw euclideanDimensionError(size_, oth.size_);
   }
+  Kernels().subtract(magnitudes_, oth.magnitudes_, Length());
   return *this;
 }
 
 EuclideanVector& EuclideanVector::operator*=(const double oth) noexcept {
-  for (int i = 0; i < size_; i++) {
-    magnitudes_[i] *= oth;
-  }
+  Kernels().scale(magnitudes_, oth, Length());
   return *this;
 }
 
@@ -109,9 +157,7 @@ EuclideanVector& EuclideanVector::operator/=(const double oth) {
   if (oth == 0) {
     throw EuclideanVectorError("Invalid vector division by 0");
   }
-  for (int i = 0; i < size_; i++) {
-    magnitudes_[i] /= oth;
-  }
+  Kernels().divide(magnitudes_, oth, Length());
   return *this;
 }
 
@@ -160,60 +206,50 @@ bool operator!=(const EuclideanVector& a, const EuclideanVector& b) noexcept {
   return !(a == b);
 }
 
-EuclideanVector operator+(const EuclideanVector& a, const EuclideanVector& b) {
+double operator*(const EuclideanVector& a, const EuclideanVector& b) {
   if (a.size_ != b.size_) {
-    throw euclideanDimensionError(a, b);
+    throw euclideanDimensionError(a.size_, b.size_);
   }
-  EuclideanVector ret(a);
-  for (int i = 0; i < a.size_; i++) {
-    ret[i] = a[i] + b[i];
-  }
-  return ret;
+  return Kernels().dot(a.magnitudes_, b.magnitudes_, a.Length());
 }
 
-EuclideanVector operator-(const EuclideanVector& a, const EuclideanVector& b) {
-  if (a.size_ != b.size_) {
-    throw euclideanDimensionError(a, b);
+/* storage */
+void EuclideanVector::Allocate(int size) {
+  // allocate before letting go of anything, so a throwing resource leaves the vector as it was
+  double* heap = nullptr;
+  if (size > kInlineDimensions) {
+    heap = static_cast<double*>(resource_->allocate(size * sizeof(double), alignof(double)));
   }
-  EuclideanVector ret(a);
-  for (int i = 0; i < a.size_; i++) {
-    ret[i] = a[i] - b[i];
+  Release();
+  size_ = size;
+  if (heap != nullptr) {
+    heap_ = heap;
+    magnitudes_ = heap_;
   }
-  return ret;
 }
 
-double operator*(const EuclideanVector& a, const EuclideanVector& b) {
-  if (a.size_ != b.size_) {
-    throw euclideanDimensionError(a, b);
+void EuclideanVector::Release() noexcept {
+  if (heap_ != nullptr) {
+    resource_->deallocate(heap_, size_ * sizeof(double), alignof(double));
+    heap_ = nullptr;
   }
-  double ret = 0;
-  for (int i = 0; i < a.size_; i++) {
-    ret += a[i] * b[i];
-  }
-  return ret;
+  magnitudes_ = inline_;
 }
 
-EuclideanVector operator*(const EuclideanVector& a, const double& b) noexcept {
-  EuclideanVector ret(a);
-  for (int i = 0; i < a.size_; i++) {
-    ret[i] = a[i] * b;
+void EuclideanVector::StealFrom(EuclideanVector& oth) {
+  if (oth.heap_ != nullptr && *resource_ == *oth.resource_) {
+    Release();
+    size_ = oth.size_;
+    heap_ = oth.heap_;
+    magnitudes_ = heap_;
+    oth.heap_ = nullptr;
+  } else {
+    Allocate(oth.size_);
+    std::copy_n(oth.magnitudes_, size_, magnitudes_);
+    oth.Release();
   }
-  return ret;
-}
-
-EuclideanVector operator*(const double& a, const EuclideanVector& b) noexcept {
-  return b * a;
-}
-
-EuclideanVector operator/(const EuclideanVector& a, const double& b) {
-  if (b == 0) {
-    throw EuclideanVectorError("Invalid vector division by 0");
-  }
-  EuclideanVector ret(a);
-  for (int i = 0; i < a.size_; i++) {
-    ret[i] = a[i] / b;
-  }
-  return ret;
+  oth.size_ = 0;
+  oth.magnitudes_ = oth.inline_;
 }
 
 /* methods */
@@ -242,11 +278,7 @@ double EuclideanVector::GetEuclideanNorm() const {
     throw EuclideanVectorError("EuclideanVector with no dimensions does not"
                                " have a norm");
   }
-  double sum = 0;
-  for (int i = 0; i < size_; i++) {
-    sum += magnitudes_[i] * magnitudes_[i];
-  }
-  return sqrt(sum);
+  return sqrt(Kernels().sum_of_squares(magnitudes_, Length()));
 }
 
 EuclideanVector EuclideanVector::CreateUnitVector() const {
@@ -258,11 +290,6 @@ EuclideanVector EuclideanVector::CreateUnitVector() const {
     throw EuclideanVectorError("EuclideanVector with euclidean normal of 0"
                                " does not have a unit vector");
   }
-  EuclideanVector ret(size_);
-  double norm = GetEuclideanNorm();
-  for (int i = 0; i < size_; i++) {
-    ret.magnitudes_[i] = magnitudes_[i] / norm;
-  }
-  return ret;
+  return *this / GetEuclideanNorm();
 }
 
@@ -2,10 +2,16 @@
 #ifndef ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_H_
 #define ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_H_
 
+#include <algorithm>
+#include <cstddef>
 #include <exception>
 #include <list>
 #include <memory>
+#include <memory_resource>
+#include <ostream>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 class EuclideanVectorError : public std::exception {
@@ -17,23 +23,64 @@ class EuclideanVectorError : public std::exception {
   std::string what_;
 };
 
+// vectors of up to EV_INLINE_DIMENSIONS dimensions keep their magnitudes inside the object
+// instead of on the heap; override it with -DEV_INLINE_DIMENSIONS=n
+#ifndef EV_INLINE_DIMENSIONS
+#define EV_INLINE_DIMENSIONS 4
+#endif
+
+class EuclideanVector;
+
+// IsVectorExpression is true for EuclideanVector and for the lazy expression types below
+template <typename T>
+struct IsVectorExpression : std::false_type {};
+template <>
+struct IsVectorExpression<EuclideanVector> : std::true_type {};
+
+template <typename T>
+using EnableIfExpression =
+    std::enable_if_t<IsVectorExpression<T>::value && !std::is_same<T, EuclideanVector>::value>;
+
+/* exception helper */
+EuclideanVectorError euclideanDimensionError(int lhs, int rhs);
+
+// Magnitudes that don't fit inline come from a std::pmr::memory_resource, the default one
+// unless a constructor is given an allocator_type (or a resource, which converts to one).
+// Like the std::pmr containers, a vector keeps its resource for life: copies use the default
+// resource, and moving between vectors with different resources copies the magnitudes
+// instead of handing over the buffer.
 class EuclideanVector {
  public:
-  explicit EuclideanVector(int i) noexcept;
-  EuclideanVector(int i, double jd) noexcept;
+  using allocator_type = std::pmr::polymorphic_allocator<double>;
+
+  explicit EuclideanVector(int i, const allocator_type& alloc = {});
+  EuclideanVector(int i, double jd, const allocator_type& alloc = {});
   EuclideanVector(std::vector<double>::const_iterator begin,
-                  std::vector<double>::const_iterator end) noexcept;
-  EuclideanVector(const EuclideanVector&) noexcept;
+                  std::vector<double>::const_iterator end,
+                  const allocator_type& alloc = {});
+  EuclideanVector(const EuclideanVector&);
+  EuclideanVector(const EuclideanVector&, const allocator_type& alloc);
+  // the resource comes along with the buffer, so moving never allocates
   EuclideanVector(EuclideanVector&&) noexcept;
 
-  ~EuclideanVector() noexcept = default;
+  // an expression such as a + b * 2.0 is evaluated here, in one pass and one allocation
+  template <typename E, typename = EnableIfExpression<E>>
+  EuclideanVector(const E& expr, const allocator_type& alloc = {});  // NOLINT(runtime/explicit)
+
+  ~EuclideanVector() noexcept;
 
-  EuclideanVector& operator=(const EuclideanVector&) noexcept;
-  EuclideanVector& operator=(EuclideanVector&&) noexcept;
+  EuclideanVector& operator=(const EuclideanVector&);
+  EuclideanVector& operator=(EuclideanVector&&);
+  template <typename E, typename = EnableIfExpression<E>>
+  EuclideanVector& operator=(const E& expr);
   double& operator[](unsigned) noexcept;
   double operator[](unsigned) const noexcept;
   EuclideanVector& operator+=(const EuclideanVector&);
   EuclideanVector& operator-=(const EuclideanVector&);
+  template <typename E, typename = EnableIfExpression<E>>
+  EuclideanVector& operator+=(const E& expr);
+  template <typename E, typename = EnableIfExpression<E>>
+  EuclideanVector& operator-=(const E& expr);
   EuclideanVector& operator*=(const double) noexcept;
   EuclideanVector& operator/=(const double);
   explicit operator std::vector<double>() noexcept;
@@ -42,23 +89,349 @@ class EuclideanVector {
   friend std::ostream& operator<<(std::ostream& os, const EuclideanVector& v) noexcept;
   friend bool operator==(const EuclideanVector&, const EuclideanVector&) noexcept;
   friend bool operator!=(const EuclideanVector&, const EuclideanVector&) noexcept;
-  friend EuclideanVector operator+(const EuclideanVector&, const EuclideanVector&);
-  friend EuclideanVector operator-(const EuclideanVector&, const EuclideanVector&);
   friend double operator*(const EuclideanVector&, const EuclideanVector&);
-  friend EuclideanVector operator*(const EuclideanVector&, const double&)noexcept;
-  friend EuclideanVector operator*(const double&, const EuclideanVector&)noexcept;
-  friend EuclideanVector operator/(const EuclideanVector&, const double&);
 
   double at(int) const;
   double& at(int);
   int GetNumDimensions() const noexcept;
   double GetEuclideanNorm() const;
   EuclideanVector CreateUnitVector() const;
+  double* data() noexcept { return magnitudes_; }
+  const double* data() const noexcept { return magnitudes_; }
+  allocator_type get_allocator() const noexcept { return resource_; }
 
  private:
+  static constexpr int kInlineDimensions = EV_INLINE_DIMENSIONS;
+  static_assert(kInlineDimensions > 0, "EV_INLINE_DIMENSIONS must be positive");
+
+  // Length is size_ as the kernels' element count
+  std::size_t Length() const noexcept { return static_cast<std::size_t>(size_); }
+
+  // Allocate releases any buffer, sets the size and points magnitudes_ at storage for it. If
+  // the resource throws, the vector keeps its old size and magnitudes.
+  void Allocate(int size);
+  void Release() noexcept;
+
+  // StealFrom takes oth's magnitudes and leaves oth with no dimensions. The heap buffer
+  // changes hands only when both vectors use the same resource.
+  void StealFrom(EuclideanVector& oth);
+
   // Private parts
+  int size_ = 0;
+  double* magnitudes_ = inline_;  // inline_ or heap_
+  double* heap_ = nullptr;        // size_ doubles from resource_, when they don't fit inline
+  std::pmr::memory_resource* resource_;
+  double inline_[kInlineDimensions] = {};
+};
+
+/* expression templates
+ *
+ * +, - and scalar * and / build a small tree of these nodes instead of a new EuclideanVector.
+ * Nothing is computed until the tree is assigned to a EuclideanVector, which then fills each
+ * dimension from the whole expression in one fused loop. Dimensions and division by zero are
+ * still checked, and still throw, when each operator is applied.
+ *
+ * Nodes refer to EuclideanVector operands rather than copying them, so an expression kept in
+ * an auto variable must not outlive the vectors it was built from.
+ */
+
+// VectorLeaf is how a node sees a EuclideanVector operand
+class VectorLeaf {
+ public:
+  VectorLeaf(const EuclideanVector& v) noexcept  // NOLINT(runtime/explicit)
+    : data_(v.data()), size_(v.GetNumDimensions()) {}
+  double operator[](unsigned i) const noexcept { return data_[i]; }
+  int GetNumDimensions() const noexcept { return size_; }
+  const double* data() const noexcept { return data_; }
+
+ private:
+  const double* data_;
   int size_;
-  std::unique_ptr<double[]> magnitudes_;
 };
 
+// ExpressionOperand stores vectors as leaves and sub-expressions by value
+template <typename T>
+using ExpressionOperand =
+    std::conditional_t<std::is_same<T, EuclideanVector>::value, VectorLeaf, T>;
+
+template <typename L, typename R>
+class VectorSum {
+ public:
+  VectorSum(const L& a, const R& b) : a_(a), b_(b) {}
+  double operator[](unsigned i) const noexcept { return a_[i] + b_[i]; }
+  int GetNumDimensions() const noexcept { return a_.GetNumDimensions(); }
+  const ExpressionOperand<L>& lhs() const noexcept { return a_; }
+  const ExpressionOperand<R>& rhs() const noexcept { return b_; }
+
+ private:
+  ExpressionOperand<L> a_;
+  ExpressionOperand<R> b_;
+};
+
+template <typename L, typename R>
+class VectorDifference {
+ public:
+  VectorDifference(const L& a, const R& b) : a_(a), b_(b) {}
+  double operator[](unsigned i) const noexcept { return a_[i] - b_[i]; }
+  int GetNumDimensions() const noexcept { return a_.GetNumDimensions(); }
+  const ExpressionOperand<L>& lhs() const noexcept { return a_; }
+  const ExpressionOperand<R>& rhs() const noexcept { return b_; }
+
+ private:
+  ExpressionOperand<L> a_;
+  ExpressionOperand<R> b_;
+};
+
+template <typename E>
+class VectorProduct {
+ public:
+  VectorProduct(const E& e, double factor) : e_(e), factor_(factor) {}
+  double operator[](unsigned i) const noexcept { return e_[i] * factor_; }
+  int GetNumDimensions() const noexcept { return e_.GetNumDimensions(); }
+  const ExpressionOperand<E>& operand() const noexcept { return e_; }
+  double factor() const noexcept { return factor_; }
+
+ private:
+  ExpressionOperand<E> e_;
+  double factor_;
+};
+
+template <typename E>
+class VectorQuotient {
+ public:
+  VectorQuotient(const E& e, double divisor) : e_(e), divisor_(divisor) {}
+  double operator[](unsigned i) const noexcept { return e_[i] / divisor_; }
+  int GetNumDimensions() const noexcept { return e_.GetNumDimensions(); }
+  const ExpressionOperand<E>& operand() const noexcept { return e_; }
+  double divisor() const noexcept { return divisor_; }
+
+ private:
+  ExpressionOperand<E> e_;
+  double divisor_;
+};
+
+template <typename L, typename R>
+struct IsVectorExpression<VectorSum<L, R>> : std::true_type {};
+template <typename L, typename R>
+struct IsVectorExpression<VectorDifference<L, R>> : std::true_type {};
+template <typename E>
+struct IsVectorExpression<VectorProduct<E>> : std::true_type {};
+template <typename E>
+struct IsVectorExpression<VectorQuotient<E>> : std::true_type {};
+
+template <typename L, typename R>
+using EnableIfVectors =
+    std::enable_if_t<IsVectorExpression<L>::value && IsVectorExpression<R>::value>;
+
+// EnableIfMixed is for operators EuclideanVector already has a non-template version of
+template <typename L, typename R>
+using EnableIfMixed = std::enable_if_t<
+    IsVectorExpression<L>::value && IsVectorExpression<R>::value &&
+    !(std::is_same<L, EuclideanVector>::value && std::is_same<R, EuclideanVector>::value)>;
+
+template <typename L, typename R>
+void CheckDimensions(const L& a, const R& b) {
+  if (a.GetNumDimensions() != b.GetNumDimensions()) {
+    throw euclideanDimensionError(a.GetNumDimensions(), b.GetNumDimensions());
+  }
+}
+
+template <typename L, typename R, typename = EnableIfVectors<L, R>>
+VectorSum<L, R> operator+(const L& a, const R& b) {
+  CheckDimensions(a, b);
+  return VectorSum<L, R>(a, b);
+}
+
+template <typename L, typename R, typename = EnableIfVectors<L, R>>
+VectorDifference<L, R> operator-(const L& a, const R& b) {
+  CheckDimensions(a, b);
+  return VectorDifference<L, R>(a, b);
+}
+
+template <typename E, typename = EnableIfVectors<E, E>>
+VectorProduct<E> operator*(const E& e, double factor) noexcept {
+  return VectorProduct<E>(e, factor);
+}
+
+template <typename E, typename = EnableIfVectors<E, E>>
+VectorProduct<E> operator*(double factor, const E& e) noexcept {
+  return VectorProduct<E>(e, factor);
+}
+
+template <typename E, typename = EnableIfVectors<E, E>>
+VectorQuotient<E> operator/(const E& e, double divisor) {
+  if (divisor == 0) {
+    throw EuclideanVectorError("Invalid vector division by 0");
+  }
+  return VectorQuotient<E>(e, divisor);
+}
+
+/* rvalue operands
+ *
+ * A vector that is about to be destroyed is a free buffer for the result: these overloads
+ * compute into it and move it out, so a temporary never dangles inside an expression and
+ * chains such as f(x) + y - z allocate nothing.
+ */
+
+template <typename E, typename = EnableIfVectors<E, E>>
+EuclideanVector operator+(EuclideanVector&& a, const E& b) {
+  a += b;
+  return std::move(a);
+}
+
+template <typename E, typename = EnableIfVectors<E, E>>
+EuclideanVector operator+(const E& a, EuclideanVector&& b) {
+  CheckDimensions(a, b);
+  b += a;
+  return std::move(b);
+}
+
+inline EuclideanVector operator+(EuclideanVector&& a, EuclideanVector&& b) {
+  a += b;
+  return std::move(a);
+}
+
+template <typename E, typename = EnableIfVectors<E, E>>
+EuclideanVector operator-(EuclideanVector&& a, const E& b) {
+  a -= b;
+  return std::move(a);
+}
+
+template <typename E, typename = EnableIfVectors<E, E>>
+EuclideanVector operator-(const E& a, EuclideanVector&& b) {
+  CheckDimensions(a, b);
+  auto* magnitudes = b.data();
+  for (int i = 0; i < b.GetNumDimensions(); i++) {
+    magnitudes[i] = a[i] - magnitudes[i];
+  }
+  return std::move(b);
+}
+
+inline EuclideanVector operator-(EuclideanVector&& a, EuclideanVector&& b) {
+  a -= b;
+  return std::move(a);
+}
+
+inline EuclideanVector operator*(EuclideanVector&& a, double factor) noexcept {
+  a *= factor;
+  return std::move(a);
+}
+
+inline EuclideanVector operator*(double factor, EuclideanVector&& a) noexcept {
+  a *= factor;
+  return std::move(a);
+}
+
+inline EuclideanVector operator/(EuclideanVector&& a, double divisor) {
+  a /= divisor;
+  return std::move(a);
+}
+
+// dot product of expressions; two plain vectors use the kernel version
+template <typename L, typename R, typename = EnableIfMixed<L, R>>
+double operator*(const L& a, const R& b) {
+  CheckDimensions(a, b);
+  double ret = 0;
+  for (int i = 0; i < a.GetNumDimensions(); i++) {
+    ret += a[i] * b[i];
+  }
+  return ret;
+}
+
+template <typename L, typename R, typename = EnableIfMixed<L, R>>
+bool operator==(const L& a, const R& b) noexcept {
+  if (a.GetNumDimensions() != b.GetNumDimensions()) {
+    return false;
+  }
+  for (int i = 0; i < a.GetNumDimensions(); i++) {
+    if (a[i] != b[i])
+      return false;
+  }
+  return true;
+}
+
+template <typename L, typename R, typename = EnableIfMixed<L, R>>
+bool operator!=(const L& a, const R& b) noexcept {
+  return !(a == b);
+}
+
+template <typename E, typename = EnableIfExpression<E>>
+std::ostream& operator<<(std::ostream& os, const E& expr) {
+  return os << EuclideanVector(expr);
+}
+
+/* evaluation
+ *
+ * EvaluateInto writes an expression into dst, one dimension at a time. A single +, -, * or /
+ * on whole EuclideanVectors, the most common expression, instead goes to the SIMD kernels
+ * through the Evaluate functions below, which give the same results bit for bit and allow dst
+ * to be one of the operands.
+ */
+
+void EvaluateSum(double* dst, const double* a, const double* b, std::size_t n);
+void EvaluateDifference(double* dst, const double* a, const double* b, std::size_t n);
+void EvaluateProduct(double* dst, const double* a, double factor, std::size_t n);
+void EvaluateQuotient(double* dst, const double* a, double divisor, std::size_t n);
+
+template <typename E>
+void EvaluateInto(double* dst, const E& expr) {
+  for (int i = 0; i < expr.GetNumDimensions(); i++) {
+    dst[i] = expr[i];
+  }
+}
+
+inline void EvaluateInto(double* dst, const VectorSum<EuclideanVector, EuclideanVector>& expr) {
+  EvaluateSum(dst, expr.lhs().data(), expr.rhs().data(), expr.GetNumDimensions());
+}
+
+inline void EvaluateInto(double* dst,
+                         const VectorDifference<EuclideanVector, EuclideanVector>& expr) {
+  EvaluateDifference(dst, expr.lhs().data(), expr.rhs().data(), expr.GetNumDimensions());
+}
+
+inline void EvaluateInto(double* dst, const VectorProduct<EuclideanVector>& expr) {
+  EvaluateProduct(dst, expr.operand().data(), expr.factor(), expr.GetNumDimensions());
+}
+
+inline void EvaluateInto(double* dst, const VectorQuotient<EuclideanVector>& expr) {
+  EvaluateQuotient(dst, expr.operand().data(), expr.divisor(), expr.GetNumDimensions());
+}
+
+template <typename E, typename>
+EuclideanVector::EuclideanVector(const E& expr, const allocator_type& alloc)
+  : resource_(alloc.resource()) {
+  Allocate(expr.GetNumDimensions());
+  EvaluateInto(magnitudes_, expr);
+}
+
+// every dimension only reads the same dimension of its operands, so an expression can be
+// evaluated straight into a vector it mentions
+template <typename E, typename>
+EuclideanVector& EuclideanVector::operator=(const E& expr) {
+  // an expression of another size cannot mention this vector, so the old buffer can go first
+  if (size_ != expr.GetNumDimensions()) {
+    Allocate(expr.GetNumDimensions());
+  }
+  EvaluateInto(magnitudes_, expr);
+  return *this;
+}
+
+template <typename E, typename>
+EuclideanVector& EuclideanVector::operator+=(const E& expr) {
+  CheckDimensions(*this, expr);
+  for (int i = 0; i < size_; i++) {
+    magnitudes_[i] += expr[i];
+  }
+  return *this;
+}
+
+template <typename E, typename>
+EuclideanVector& EuclideanVector::operator-=(const E& expr) {
+  CheckDimensions(*this, expr);
+  for (int i = 0; i < size_; i++) {
+    magnitudes_[i] -= expr[i];
+  }
+  return *this;
+}
+
 #endif  // ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_H_
@@ -0,0 +1,164 @@
+#include "assignments/ev/euclidean_vector_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/vector_kernels.h"
+
+namespace {
+
+const std::size_t kAlignment = 64;
+const std::size_t kDoublesPerLine = kAlignment / sizeof(double);
+
+std::size_t RoundToLine(std::size_t n) {
+  return (n + kDoublesPerLine - 1) / kDoublesPerLine * kDoublesPerLine;
+}
+
+}  // namespace
+
+void EuclideanVectorBatch::AlignedDelete::operator()(double* p) const noexcept {
+  ::operator delete[](p, std::align_val_t(kAlignment));
+}
+
+EuclideanVectorBatch::EuclideanVectorBatch(int size, int dimensions, BatchLayout layout)
+  : size_(size), dimensions_(dimensions), layout_(layout) {
+  const auto rows = static_cast<std::size_t>(layout == BatchLayout::kRowMajor ? size : dimensions);
+  leading_ = RoundToLine(static_cast<std::size_t>(layout == BatchLayout::kRowMajor ? dimensions
+                                                                                     : size));
+  const auto count = std::max<std::size_t>(rows * leading_, 1);
+  data_.reset(static_cast<double*>(
+      ::operator new[](count * sizeof(double), std::align_val_t(kAlignment))));
+  std::fill_n(data_.get(), count, 0.0);
+}
+
+EuclideanVectorBatch EuclideanVectorBatch::FromVectors(const std::vector<EuclideanVector>& vectors,
+                                                       BatchLayout layout) {
+  const int dimensions = vectors.empty() ? 0 : vectors.front().GetNumDimensions();
+  EuclideanVectorBatch ret(static_cast<int>(vectors.size()), dimensions, layout);
+  for (int i = 0; i < ret.size_; i++) {
+    ret.Set(i, vectors[i]);
+  }
+  return ret;
+}
+
+EuclideanVectorView EuclideanVectorBatch::operator[](int i) noexcept {
+  if (layout_ == BatchLayout::kRowMajor) {
+    return {data_.get() + i * leading_, dimensions_, 1};
+  }
+  return {data_.get() + i, dimensions_, leading_};
+}
+
+ConstEuclideanVectorView EuclideanVectorBatch::operator[](int i) const noexcept {
+  return const_cast<EuclideanVectorBatch&>(*this)[i];
+}
+
+EuclideanVectorView EuclideanVectorBatch::at(int i) {
+  CheckIndex(i);
+  return (*this)[i];
+}
+
+ConstEuclideanVectorView EuclideanVectorBatch::at(int i) const {
+  CheckIndex(i);
+  return (*this)[i];
+}
+
+void EuclideanVectorBatch::CheckIndex(int i) const {
+  if (i < 0 || i >= size_) {
+    throw EuclideanVectorError(static_cast<std::string>("Index ") + std::to_string(i) +
+                               " is not valid for this EuclideanVectorBatch object");
+  }
+}
+
+void EuclideanVectorBatch::Set(int i, const EuclideanVector& v) {
+  CheckIndex(i);
+  if (v.GetNumDimensions() != dimensions_) {
+    throw euclideanDimensionError(dimensions_, v.GetNumDimensions());
+  }
+  const auto view = (*this)[i];
+  for (int j = 0; j < dimensions_; j++) {
+    view[j] = v[j];
+  }
+}
+
+EuclideanVectorBatch EuclideanVectorBatch::WithLayout(BatchLayout layout) const {
+  EuclideanVectorBatch ret(size_, dimensions_, layout);
+  for (int i = 0; i < size_; i++) {
+    const auto from = (*this)[i];
+    const auto to = ret[i];
+    for (int j = 0; j < dimensions_; j++) {
+      to[j] = from[j];
+    }
+  }
+  return ret;
+}
+
+std::vector<double> EuclideanVectorBatch::Norms() const {
+  auto ret = SquaredNorms();
+  for (auto& norm : ret) {
+    norm = std::sqrt(norm);
+  }
+  return ret;
+}
+
+std::vector<double> EuclideanVectorBatch::SquaredNorms() const {
+  std::vector<double> ret(size_, 0.0);
+  const auto& kernels = Kernels();
+  if (layout_ == BatchLayout::kRowMajor) {
+    for (int i = 0; i < size_; i++) {
+      ret[i] = kernels.sum_of_squares(data_.get() + i * leading_, dimensions_);
+    }
+  } else {
+    for (int j = 0; j < dimensions_; j++) {
+      const auto* column = data_.get() + j * leading_;
+      kernels.multiply_add(ret.data(), column, column, size_);
+    }
+  }
+  return ret;
+}
+
+void EuclideanVectorBatch::NormaliseAll() {
+  if (dimensions_ == 0 && size_ > 0) {
+    throw EuclideanVectorError("EuclideanVector with no dimensions does not"
+                               " have a unit vector");
+  }
+  const auto norms = Norms();
+  if (std::find(norms.begin(), norms.end(), 0.0) != norms.end()) {
+    throw EuclideanVectorError("EuclideanVector with euclidean normal of 0"
+                               " does not have a unit vector");
+  }
+  if (layout_ == BatchLayout::kRowMajor) {
+    for (int i = 0; i < size_; i++) {
+      Kernels().divide(data_.get() + i * leading_, norms[i], dimensions_);
+    }
+    return;
+  }
+  for (int j = 0; j < dimensions_; j++) {
+    auto* column = data_.get() + j * leading_;
+    for (int i = 0; i < size_; i++) {
+      column[i] /= norms[i];
+    }
+  }
+}
+
+std::vector<double> EuclideanVectorBatch::Dot(const EuclideanVector& query) const {
+  if (query.GetNumDimensions() != dimensions_) {
+    throw euclideanDimensionError(dimensions_, query.GetNumDimensions());
+  }
+  std::vector<double> ret(size_, 0.0);
+  const auto& kernels = Kernels();
+  if (layout_ == BatchLayout::kRowMajor) {
+    for (int i = 0; i < size_; i++) {
+      ret[i] = kernels.dot(data_.get() + i * leading_, query.data(), dimensions_);
+    }
+  } else {
+    for (int j = 0; j < dimensions_; j++) {
+      kernels.axpy(ret.data(), query[j], data_.get() + j * leading_, size_);
+    }
+  }
+  return ret;
+}
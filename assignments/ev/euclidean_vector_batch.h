@@ -0,0 +1,120 @@
+#ifndef ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_BATCH_H_
+#define ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_BATCH_H_
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// BasicVectorView is one vector of a EuclideanVectorBatch, seen in place. It is a vector
+// expression, so it can be printed, compared, combined with EuclideanVectors and assigned to
+// one, but it owns nothing and is only valid while its batch is. A view of a column-major
+// batch strides through memory. Assigning to a view writes into the batch; it never re-points
+// the view.
+template <typename T>
+class BasicVectorView {
+ public:
+  BasicVectorView(T* data, int size, std::size_t stride) noexcept
+    : data_(data), size_(size), stride_(stride) {}
+  BasicVectorView(const BasicVectorView&) noexcept = default;
+  template <typename U, typename = std::enable_if_t<std::is_convertible<U*, T*>::value>>
+  BasicVectorView(const BasicVectorView<U>& oth) noexcept  // NOLINT(runtime/explicit)
+    : data_(oth.data()), size_(oth.GetNumDimensions()), stride_(oth.stride()) {}
+
+  // the dimensions are checked before anything is written. Views of one batch are either the
+  // same vector or disjoint, so each dimension can be written as soon as it is evaluated.
+  BasicVectorView& operator=(const BasicVectorView& oth) { return Assign(oth); }
+  template <typename E, typename = std::enable_if_t<IsVectorExpression<E>::value>>
+  BasicVectorView& operator=(const E& expr) {
+    return Assign(expr);
+  }
+
+  T& operator[](unsigned i) const noexcept { return data_[i * stride_]; }
+  int GetNumDimensions() const noexcept { return size_; }
+  T* data() const noexcept { return data_; }
+  std::size_t stride() const noexcept { return stride_; }
+
+ private:
+  template <typename E>
+  BasicVectorView& Assign(const E& expr) {
+    CheckDimensions(*this, expr);
+    for (int i = 0; i < size_; ++i) {
+      (*this)[i] = expr[i];
+    }
+    return *this;
+  }
+
+  T* data_;
+  int size_;
+  std::size_t stride_;
+};
+
+using EuclideanVectorView = BasicVectorView<double>;
+using ConstEuclideanVectorView = BasicVectorView<const double>;
+
+template <typename T>
+struct IsVectorExpression<BasicVectorView<T>> : std::true_type {};
+
+// kRowMajor keeps each vector's dimensions together, which suits per-vector work and dot
+// products against one query. kColumnMajor keeps each dimension of every vector together,
+// so batched operations stream down columns and vectorise across vectors.
+enum class BatchLayout { kRowMajor, kColumnMajor };
+
+// EuclideanVectorBatch holds size() vectors of the same dimension in one 64-byte aligned
+// buffer. Each row (or column) is padded to a whole number of cache lines so every one of
+// them starts aligned. Batches move but do not copy.
+class EuclideanVectorBatch {
+ public:
+  EuclideanVectorBatch(int size, int dimensions, BatchLayout layout = BatchLayout::kRowMajor);
+  static EuclideanVectorBatch FromVectors(const std::vector<EuclideanVector>& vectors,
+                                          BatchLayout layout = BatchLayout::kRowMajor);
+
+  EuclideanVectorView operator[](int i) noexcept;
+  ConstEuclideanVectorView operator[](int i) const noexcept;
+  EuclideanVectorView at(int i);
+  ConstEuclideanVectorView at(int i) const;
+
+  // Set copies v into vector i
+  void Set(int i, const EuclideanVector& v);
+
+  int size() const noexcept { return size_; }
+  int GetNumDimensions() const noexcept { return dimensions_; }
+  BatchLayout layout() const noexcept { return layout_; }
+
+  // data() is the start of the buffer; element (vector i, dimension j) is at
+  // i * leading_dimension() + j when row-major and j * leading_dimension() + i when not
+  double* data() noexcept { return data_.get(); }
+  const double* data() const noexcept { return data_.get(); }
+  std::size_t leading_dimension() const noexcept { return leading_; }
+
+  // WithLayout returns a copy of the batch stored in the given layout
+  EuclideanVectorBatch WithLayout(BatchLayout layout) const;
+
+  // Norms returns every vector's euclidean norm and SquaredNorms its square
+  std::vector<double> Norms() const;
+  std::vector<double> SquaredNorms() const;
+
+  // NormaliseAll turns every vector into its unit vector. If any vector has a norm of 0 it
+  // throws, as CreateUnitVector does, and leaves the batch untouched.
+  void NormaliseAll();
+
+  // Dot returns the dot product of every vector with query
+  std::vector<double> Dot(const EuclideanVector& query) const;
+
+ private:
+  struct AlignedDelete {
+    void operator()(double* p) const noexcept;
+  };
+
+  void CheckIndex(int i) const;
+
+  int size_;
+  int dimensions_;
+  BatchLayout layout_;
+  std::size_t leading_;
+  std::unique_ptr<double[], AlignedDelete> data_;
+};
+
+#endif  // ASSIGNMENTS_EV_EUCLIDEAN_VECTOR_BATCH_H_
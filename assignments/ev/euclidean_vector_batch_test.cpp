@@ -0,0 +1,177 @@
+/*
+
+   Overall approach:
+    - Build the same vectors in both layouts and compare every batched result with what
+      EuclideanVector computes for each vector on its own
+    - Use dimensions and batch sizes that are not multiples of the padding, so padded rows and
+      columns are exercised
+    - Check views behave as vector expressions and write through to the batch
+    - Check errors are thrown before anything in the batch changes
+
+*/
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+namespace {
+
+const char* LayoutName(BatchLayout layout) {
+  return layout == BatchLayout::kRowMajor ? "row-major" : "column-major";
+}
+
+}  // namespace
+
+SCENARIO("EuclideanVectorBatch matches EuclideanVector in both layouts") {
+  const auto vectors = WaveVectors(13, 11, 0.5);
+  EuclideanVector query(11);
+  for (int j = 0; j < 11; j++) {
+    query[j] = 1.0 - j * 0.375;
+  }
+
+  for (const auto layout : {BatchLayout::kRowMajor, BatchLayout::kColumnMajor}) {
+    GIVEN(std::string("A ") + LayoutName(layout) + " batch of 13 vectors with 11 dimensions") {
+      auto batch = EuclideanVectorBatch::FromVectors(vectors, layout);
+
+      THEN("Its shape and storage are as described") {
+        REQUIRE(batch.size() == 13);
+        REQUIRE(batch.GetNumDimensions() == 11);
+        REQUIRE(batch.layout() == layout);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(batch.data()) % 64 == 0);
+        REQUIRE(batch.leading_dimension() % 8 == 0);
+        REQUIRE(batch.leading_dimension() >= 11);
+      }
+
+      THEN("Every view reads back the vector it was built from") {
+        for (int i = 0; i < batch.size(); i++) {
+          REQUIRE(static_cast<EuclideanVector>(batch[i]) == vectors[i]);
+          REQUIRE(batch.at(i) == vectors[i]);
+        }
+      }
+
+      WHEN("I take every norm and every dot product with a query") {
+        const auto norms = batch.Norms();
+        const auto dots = batch.Dot(query);
+        THEN("They match each vector's own") {
+          REQUIRE(norms.size() == 13);
+          REQUIRE(dots.size() == 13);
+          for (int i = 0; i < 13; i++) {
+            REQUIRE(norms[i] == Approx(vectors[i].GetEuclideanNorm()));
+            REQUIRE(dots[i] == Approx(vectors[i] * query));
+          }
+        }
+      }
+
+      WHEN("I normalise every vector") {
+        batch.NormaliseAll();
+        THEN("Each one is its unit vector") {
+          for (int i = 0; i < 13; i++) {
+            const auto expected = vectors[i].CreateUnitVector();
+            for (int j = 0; j < 11; j++) {
+              REQUIRE(batch[i][j] == Approx(expected[j]));
+            }
+          }
+        }
+      }
+
+      WHEN("I use views in expressions and write through them") {
+        const EuclideanVector sum = batch[0] + batch[1] * 2 - vectors[2];
+        batch[3][4] = 100;
+        batch.Set(5, query);
+        THEN("The results are as if the views were EuclideanVectors") {
+          REQUIRE(sum == vectors[0] + vectors[1] * 2 - vectors[2]);
+          REQUIRE(batch[3][4] == 100);
+          REQUIRE(batch[5] == query);
+          REQUIRE(batch[4] == vectors[4]);
+          std::ostringstream got, want;
+          got << batch[5];
+          want << query;
+          REQUIRE(got.str() == want.str());
+        }
+      }
+
+      WHEN("I assign vectors and expressions to views") {
+        batch[0] = batch[1];
+        auto view = batch[2];
+        view = vectors[3] * 2;
+        batch[4] = batch[4] + query;
+        THEN("The batch holds the assigned values and the views still point where they did") {
+          REQUIRE(batch[0] == vectors[1]);
+          REQUIRE(batch[2] == vectors[3] * 2);
+          REQUIRE(view.data() == batch[2].data());
+          REQUIRE(batch[3] == vectors[3]);
+          REQUIRE(batch[4] == vectors[4] + query);
+        }
+      }
+
+      WHEN("I copy the batch into each layout") {
+        THEN("The copies hold the same vectors") {
+          for (const auto to : {BatchLayout::kRowMajor, BatchLayout::kColumnMajor}) {
+            const auto copy = batch.WithLayout(to);
+            REQUIRE(copy.layout() == to);
+            for (int i = 0; i < 13; i++) {
+              REQUIRE(copy[i] == vectors[i]);
+            }
+          }
+        }
+      }
+
+      WHEN("I move the batch") {
+        const auto* data = batch.data();
+        auto moved = std::move(batch);
+        THEN("The storage moves with it") {
+          REQUIRE(moved.data() == data);
+          REQUIRE(moved[12] == vectors[12]);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("EuclideanVectorBatch errors") {
+  for (const auto layout : {BatchLayout::kRowMajor, BatchLayout::kColumnMajor}) {
+    GIVEN(std::string("A ") + LayoutName(layout) + " batch whose last vector is zero") {
+      auto vectors = WaveVectors(3, 4, 0.5);
+      vectors[2] = EuclideanVector(4);
+      auto batch = EuclideanVectorBatch::FromVectors(vectors, layout);
+
+      THEN("Bad indices and mismatched dimensions throw") {
+        REQUIRE_THROWS_WITH(batch.at(3),
+                            "Index 3 is not valid for this EuclideanVectorBatch object");
+        REQUIRE_THROWS_WITH(batch.at(-1),
+                            "Index -1 is not valid for this EuclideanVectorBatch object");
+        REQUIRE_THROWS_WITH(batch.Set(0, EuclideanVector(5)),
+                            "Dimensions of LHS(4) and RHS(5) do not match");
+        REQUIRE_THROWS_WITH(batch.Dot(EuclideanVector(3)),
+                            "Dimensions of LHS(4) and RHS(3) do not match");
+        REQUIRE_THROWS_WITH(batch[0] = EuclideanVector(5),
+                            "Dimensions of LHS(4) and RHS(5) do not match");
+        REQUIRE(batch[0] == vectors[0]);
+      }
+
+      THEN("Normalising throws and leaves every vector as it was") {
+        REQUIRE_THROWS_WITH(batch.NormaliseAll(), "EuclideanVector with euclidean normal of 0"
+                                                  " does not have a unit vector");
+        for (int i = 0; i < 3; i++) {
+          REQUIRE(batch[i] == vectors[i]);
+        }
+      }
+    }
+  }
+
+  GIVEN("An empty batch") {
+    const EuclideanVectorBatch batch(0, 3);
+    THEN("Its batched results are empty") {
+      REQUIRE(batch.size() == 0);
+      REQUIRE(batch.Norms().empty());
+      REQUIRE(batch.Dot(EuclideanVector(3)).empty());
+    }
+  }
+}
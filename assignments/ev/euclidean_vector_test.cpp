@@ -11,9 +11,13 @@
 
 // "assignments/ev/euclidean_vector"
 #include <cmath>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "assignments/ev/euclidean_vector.h"
 #include "catch.h"
@@ -376,3 +380,253 @@ SCENARIO("Using member functions of the class") {
     }
   }
 }
+
+/* expression template testing */
+SCENARIO("Using compound EuclideanVector expressions") {
+  GIVEN("Three Euclidean Vectors of equal size") {
+    const std::vector<double> av{1, 2, 3};
+    const std::vector<double> bv{0.5, -1, 4};
+    const std::vector<double> cv{2, 2, 2};
+    EuclideanVector a(av.begin(), av.end());
+    const EuclideanVector b(bv.begin(), bv.end());
+    const EuclideanVector c(cv.begin(), cv.end());
+
+    WHEN("I evaluate a + b * 2.0 - c / 2") {
+      EuclideanVector rt = a + b * 2.0 - c / 2;
+      THEN("Every dimension matches the element-by-element result") {
+        REQUIRE(rt.GetNumDimensions() == correct_size);
+        for (unsigned i = 0; i < correct_size; i++) {
+          REQUIRE(rt[i] == av[i] + bv[i] * 2.0 - cv[i] / 2);
+        }
+      }
+    }
+
+    WHEN("I assign an expression that uses the destination") {
+      a = (a + b) * 2.0 - a;
+      THEN("Each dimension is computed from the old values") {
+        for (unsigned i = 0; i < correct_size; i++) {
+          REQUIRE(a[i] == (av[i] + bv[i]) * 2.0 - av[i]);
+        }
+      }
+    }
+
+    WHEN("I compare, print and take dot products of expressions") {
+      std::ostringstream buf;
+      buf << b + c;
+      THEN("They behave like the vectors they evaluate to") {
+        REQUIRE(buf.str() == "[2.5 1 6]");
+        REQUIRE((b + c) == EuclideanVector(b) + c);
+        REQUIRE(c * 2.0 != c);
+        REQUIRE((a - c) * b == -0.5 + 0 + 4);
+      }
+    }
+  }
+
+  GIVEN("Euclidean Vectors of different sizes") {
+    EuclideanVector a(correct_size, some_double);
+    EuclideanVector b(correct_size, some_double);
+    EuclideanVector c(another_size, some_double);
+
+    WHEN("A mismatch is buried inside an expression") {
+      THEN("The same exception is thrown as for a single operator") {
+        REQUIRE_THROWS_WITH(a + b * 2.0 - c, "Dimensions of LHS(" +
+                                                 std::to_string(correct_size) + ") and RHS(" +
+                                                 std::to_string(another_size) +
+                                                 ") do not match");
+        REQUIRE_THROWS_WITH(a += c * 2.0, "Dimensions of LHS(" + std::to_string(correct_size) +
+                                              ") and RHS(" + std::to_string(another_size) +
+                                              ") do not match");
+        REQUIRE_THROWS_WITH((a + b) / 0, "Invalid vector division by 0");
+      }
+    }
+  }
+}
+
+/* small buffer testing */
+SCENARIO("Copying and moving vectors on both sides of the inline threshold") {
+  for (const int siz : {1, EV_INLINE_DIMENSIONS, EV_INLINE_DIMENSIONS + 1, 64}) {
+    GIVEN("A vector with " + std::to_string(siz) + " dimensions") {
+      std::vector<double> values;
+      for (int i = 0; i < siz; i++) {
+        values.push_back(i * some_double);
+      }
+      EuclideanVector ev(values.begin(), values.end());
+
+      WHEN("I copy it and change the original") {
+        EuclideanVector copy(ev);
+        EuclideanVector assigned(1);
+        assigned = ev;
+        ev[0] = -1;
+        THEN("The copies keep their own magnitudes") {
+          REQUIRE(copy == EuclideanVector(values.begin(), values.end()));
+          REQUIRE(assigned == copy);
+          REQUIRE(copy.data() != ev.data());
+        }
+      }
+
+      WHEN("I move it into a new vector and back") {
+        EuclideanVector moved(std::move(ev));
+        ev = std::move(moved);
+        THEN("The magnitudes follow and the source is left empty") {
+          REQUIRE(ev == EuclideanVector(values.begin(), values.end()));
+          REQUIRE(moved.GetNumDimensions() == 0);
+          moved = ev;
+          REQUIRE(moved == ev);
+        }
+      }
+
+      WHEN("I assign it to itself") {
+        auto& self = ev;
+        ev = self;
+        THEN("Nothing changes") { REQUIRE(ev == EuclideanVector(values.begin(), values.end())); }
+      }
+    }
+  }
+}
+
+/* rvalue operand testing */
+SCENARIO("Using temporaries in arithmetic") {
+  GIVEN("Two heap-sized vectors") {
+    const int siz = 64;
+    EuclideanVector a(siz, 2.0);
+    const EuclideanVector b(siz, 0.5);
+
+    WHEN("I add to, subtract from, scale and divide a temporary") {
+      EuclideanVector tmp(a);
+      const auto* buffer = tmp.data();
+      EuclideanVector rt = (b - ((std::move(tmp) + b) * 4.0 / 2.0 - a));
+      THEN("The result is right and lives in the temporary's buffer") {
+        REQUIRE(rt == EuclideanVector(siz, 0.5 - ((2.0 + 0.5) * 4.0 / 2.0 - 2.0)));
+        REQUIRE(rt.data() == buffer);
+      }
+    }
+
+    WHEN("Both operands are temporaries") {
+      const auto rt = EuclideanVector(siz, 1.0) + EuclideanVector(siz, 2.0);
+      THEN("The result is right") { REQUIRE(rt == EuclideanVector(siz, 3.0)); }
+    }
+
+    WHEN("I copy-assign a vector of the same size") {
+      const auto* buffer = a.data();
+      a = b;
+      THEN("The existing buffer is reused") {
+        REQUIRE(a == b);
+        REQUIRE(a.data() == buffer);
+      }
+    }
+
+    WHEN("A temporary has the wrong size") {
+      THEN("The dimension error is still thrown") {
+        REQUIRE_THROWS_WITH(EuclideanVector(correct_size) + b,
+                            "Dimensions of LHS(" + std::to_string(correct_size) + ") and RHS(" +
+                                std::to_string(siz) + ") do not match");
+        REQUIRE_THROWS_WITH(b + EuclideanVector(correct_size),
+                            "Dimensions of LHS(" + std::to_string(siz) + ") and RHS(" +
+                                std::to_string(correct_size) + ") do not match");
+        REQUIRE_THROWS_WITH(b - EuclideanVector(correct_size),
+                            "Dimensions of LHS(" + std::to_string(siz) + ") and RHS(" +
+                                std::to_string(correct_size) + ") do not match");
+      }
+    }
+  }
+}
+
+/* memory resource testing */
+namespace {
+
+// CountingResource forwards to the default resource and counts what goes through it
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  int allocations = 0;
+  int deallocations = 0;
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t align) override {
+    ++allocations;
+    return std::pmr::get_default_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+    ++deallocations;
+    std::pmr::get_default_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+}  // namespace
+
+SCENARIO("Backing EuclideanVectors with a memory resource") {
+  GIVEN("A counting resource") {
+    CountingResource resource;
+
+    WHEN("I make small and large vectors from it") {
+      {
+        EuclideanVector small(correct_size, some_double, &resource);
+        EuclideanVector large(64, some_double, &resource);
+        EuclideanVector zeros(64, &resource);
+        REQUIRE(large.get_allocator().resource() == &resource);
+        REQUIRE(zeros == EuclideanVector(64, 0.0));
+        large += zeros;
+      }
+      THEN("Only the large ones allocate, and everything is given back") {
+        REQUIRE(resource.allocations == 2);
+        REQUIRE(resource.deallocations == 2);
+      }
+    }
+
+    WHEN("I move a vector to another on the same resource") {
+      EuclideanVector from(64, some_double, &resource);
+      EuclideanVector to(std::move(from));
+      THEN("The buffer changes hands without allocating") {
+        REQUIRE(resource.allocations == 1);
+        REQUIRE(to.get_allocator().resource() == &resource);
+        REQUIRE(to == EuclideanVector(64, some_double));
+      }
+    }
+
+    WHEN("I move-assign into a vector on the default resource") {
+      EuclideanVector from(64, some_double, &resource);
+      EuclideanVector to(64);
+      to = std::move(from);
+      THEN("The magnitudes are copied and the source's buffer is released") {
+        REQUIRE(to == EuclideanVector(64, some_double));
+        REQUIRE(to.get_allocator().resource() == std::pmr::get_default_resource());
+        REQUIRE(from.GetNumDimensions() == 0);
+        REQUIRE(resource.deallocations == 1);
+      }
+    }
+  }
+
+  GIVEN("A monotonic arena on the stack") {
+    alignas(double) char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                              std::pmr::null_memory_resource());
+
+    WHEN("I do arithmetic with vectors from the arena") {
+      EuclideanVector a(32, 1.0, &arena);
+      EuclideanVector b(32, 2.0, &arena);
+      EuclideanVector sum(a + b * 2.0, &arena);
+      THEN("Their magnitudes live in the arena") {
+        REQUIRE(sum == EuclideanVector(32, 5.0));
+        REQUIRE(static_cast<const void*>(sum.data()) >= buffer);
+        REQUIRE(static_cast<const void*>(sum.data()) < buffer + sizeof(buffer));
+      }
+    }
+
+    WHEN("I assign vectors too large for what is left of the arena") {
+      EuclideanVector v(8, 3.0, &arena);
+      const EuclideanVector big(1000, 1.0);
+      EuclideanVector expiring(1000, 1.0);
+      THEN("Each assignment throws and leaves the vector as it was") {
+        REQUIRE_THROWS_AS(v = big, std::bad_alloc);
+        REQUIRE(v == EuclideanVector(8, 3.0));
+        REQUIRE_THROWS_AS(v = std::move(expiring), std::bad_alloc);
+        REQUIRE(v == EuclideanVector(8, 3.0));
+        REQUIRE(expiring.GetNumDimensions() == 1000);
+        REQUIRE_THROWS_AS(v = big + big, std::bad_alloc);
+        REQUIRE(v == EuclideanVector(8, 3.0));
+      }
+    }
+  }
+}
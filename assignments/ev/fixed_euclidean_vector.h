@@ -0,0 +1,185 @@
+#ifndef ASSIGNMENTS_EV_FIXED_EUCLIDEAN_VECTOR_H_
+#define ASSIGNMENTS_EV_FIXED_EUCLIDEAN_VECTOR_H_
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// FixedEuclideanVector is a EuclideanVector whose number of dimensions is part of its type.
+// Mixing dimensions is a compile error rather than an exception, storage is a std::array with
+// no allocation, and all arithmetic is constexpr so fixed-size loops unroll or fold away.
+template <std::size_t N>
+class FixedEuclideanVector {
+ public:
+  constexpr FixedEuclideanVector() noexcept : magnitudes_{} {}
+
+  // one magnitude per dimension, e.g. FixedEuclideanVector<3>(1, 2, 3)
+  template <typename... Ts,
+            typename = std::enable_if_t<sizeof...(Ts) == N && N != 0 &&
+                                        std::conjunction<std::is_arithmetic<Ts>...>::value>>
+  constexpr FixedEuclideanVector(Ts... mags) noexcept  // NOLINT(runtime/explicit)
+    : magnitudes_{{static_cast<double>(mags)...}} {}
+
+  explicit FixedEuclideanVector(const EuclideanVector& oth) : magnitudes_{} {
+    if (oth.GetNumDimensions() != static_cast<int>(N)) {
+      throw euclideanDimensionError(static_cast<int>(N), oth.GetNumDimensions());
+    }
+    for (std::size_t i = 0; i < N; i++) {
+      magnitudes_[i] = oth[i];
+    }
+  }
+
+  static constexpr FixedEuclideanVector Filled(double mag) noexcept {
+    FixedEuclideanVector ret;
+    for (std::size_t i = 0; i < N; i++) {
+      ret.magnitudes_[i] = mag;
+    }
+    return ret;
+  }
+
+  explicit operator EuclideanVector() const {
+    EuclideanVector ret(static_cast<int>(N));
+    for (std::size_t i = 0; i < N; i++) {
+      ret[i] = magnitudes_[i];
+    }
+    return ret;
+  }
+
+  constexpr double& operator[](std::size_t i) noexcept { return magnitudes_[i]; }
+  constexpr double operator[](std::size_t i) const noexcept { return magnitudes_[i]; }
+
+  constexpr FixedEuclideanVector& operator+=(const FixedEuclideanVector& oth) noexcept {
+    for (std::size_t i = 0; i < N; i++) {
+      magnitudes_[i] += oth.magnitudes_[i];
+    }
+    return *this;
+  }
+
+  constexpr FixedEuclideanVector& operator-=(const FixedEuclideanVector& oth) noexcept {
+    for (std::size_t i = 0; i < N; i++) {
+      magnitudes_[i] -= oth.magnitudes_[i];
+    }
+    return *this;
+  }
+
+  constexpr FixedEuclideanVector& operator*=(double oth) noexcept {
+    for (std::size_t i = 0; i < N; i++) {
+      magnitudes_[i] *= oth;
+    }
+    return *this;
+  }
+
+  constexpr FixedEuclideanVector& operator/=(double oth) {
+    if (oth == 0) {
+      throw EuclideanVectorError("Invalid vector division by 0");
+    }
+    for (std::size_t i = 0; i < N; i++) {
+      magnitudes_[i] /= oth;
+    }
+    return *this;
+  }
+
+  friend constexpr bool operator==(const FixedEuclideanVector& a,
+                                   const FixedEuclideanVector& b) noexcept {
+    for (std::size_t i = 0; i < N; i++) {
+      if (a.magnitudes_[i] != b.magnitudes_[i])
+        return false;
+    }
+    return true;
+  }
+
+  friend constexpr bool operator!=(const FixedEuclideanVector& a,
+                                   const FixedEuclideanVector& b) noexcept {
+    return !(a == b);
+  }
+
+  friend constexpr FixedEuclideanVector operator+(FixedEuclideanVector a,
+                                                  const FixedEuclideanVector& b) noexcept {
+    return a += b;
+  }
+
+  friend constexpr FixedEuclideanVector operator-(FixedEuclideanVector a,
+                                                  const FixedEuclideanVector& b) noexcept {
+    return a -= b;
+  }
+
+  friend constexpr double operator*(const FixedEuclideanVector& a,
+                                    const FixedEuclideanVector& b) noexcept {
+    double ret = 0;
+    for (std::size_t i = 0; i < N; i++) {
+      ret += a.magnitudes_[i] * b.magnitudes_[i];
+    }
+    return ret;
+  }
+
+  friend constexpr FixedEuclideanVector operator*(FixedEuclideanVector a, double b) noexcept {
+    return a *= b;
+  }
+
+  friend constexpr FixedEuclideanVector operator*(double a, FixedEuclideanVector b) noexcept {
+    return b *= a;
+  }
+
+  friend constexpr FixedEuclideanVector operator/(FixedEuclideanVector a, double b) {
+    return a /= b;
+  }
+
+  friend std::ostream& operator<<(std::ostream& os, const FixedEuclideanVector& v) {
+    os << "[";
+    for (std::size_t i = 0; i < N; i++) {
+      os << v.magnitudes_[i];
+      if (i + 1 < N) {
+        os << " ";
+      }
+    }
+    os << "]";
+    return os;
+  }
+
+  constexpr double at(int ind) const { return magnitudes_[CheckIndex(ind)]; }
+  constexpr double& at(int ind) { return magnitudes_[CheckIndex(ind)]; }
+
+  static constexpr int GetNumDimensions() noexcept { return static_cast<int>(N); }
+
+  // SquaredNorm is the constexpr part of GetEuclideanNorm
+  constexpr double SquaredNorm() const noexcept { return *this * *this; }
+
+  double GetEuclideanNorm() const {
+    if (N == 0) {
+      throw EuclideanVectorError("EuclideanVector with no dimensions does not"
+                                 " have a norm");
+    }
+    return std::sqrt(SquaredNorm());
+  }
+
+  FixedEuclideanVector CreateUnitVector() const {
+    if (N == 0) {
+      throw EuclideanVectorError("EuclideanVector with no dimensions does not"
+                                 " have a unit vector");
+    }
+    const auto norm = GetEuclideanNorm();
+    if (norm == 0) {
+      throw EuclideanVectorError("EuclideanVector with euclidean normal of 0"
+                                 " does not have a unit vector");
+    }
+    return *this / norm;
+  }
+
+ private:
+  static constexpr std::size_t CheckIndex(int ind) {
+    if (ind < 0 || ind >= static_cast<int>(N)) {
+      throw EuclideanVectorError(static_cast<std::string>("Index ") + std::to_string(ind) +
+                                 " is not valid for this EuclideanVector object");
+    }
+    return static_cast<std::size_t>(ind);
+  }
+
+  std::array<double, N> magnitudes_;
+};
+
+#endif  // ASSIGNMENTS_EV_FIXED_EUCLIDEAN_VECTOR_H_
@@ -0,0 +1,79 @@
+/*
+
+   Overall approach:
+    - Check arithmetic in constant expressions with static_assert
+    - Unit test the runtime-only parts: norms, at, streaming
+    - Check conversions to and from EuclideanVector, including dimension mismatch
+
+*/
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/fixed_euclidean_vector.h"
+#include "catch.h"
+
+using Vec3 = FixedEuclideanVector<3>;
+
+constexpr Vec3 kA(1, 2, 3);
+constexpr Vec3 kB(0.5, -1, 4);
+
+static_assert(Vec3::GetNumDimensions() == 3, "dimensions are part of the type");
+static_assert(kA + kB == Vec3(1.5, 1, 7), "constexpr addition");
+static_assert(kA - kB == Vec3(0.5, 3, -1), "constexpr subtraction");
+static_assert(kA * kB == 0.5 - 2 + 12, "constexpr dot product");
+static_assert(2 * kA == kA * 2.0 && kA * 2.0 == Vec3(2, 4, 6), "constexpr scaling");
+static_assert(kA / 2 == Vec3(0.5, 1, 1.5), "constexpr division");
+static_assert(Vec3::Filled(2).SquaredNorm() == 12, "constexpr squared norm");
+static_assert(kA.at(2) == 3, "constexpr at");
+static_assert(!std::is_constructible<Vec3, double, double>::value, "wrong number of magnitudes");
+static_assert(sizeof(Vec3) == 3 * sizeof(double), "no storage beyond the magnitudes");
+
+SCENARIO("Using FixedEuclideanVector at run time") {
+  GIVEN("A three dimension vector") {
+    Vec3 ev(3, 4, 12);
+
+    WHEN("I take its norm and unit vector") {
+      THEN("They match the dynamic EuclideanVector") {
+        REQUIRE(ev.GetEuclideanNorm() == 13);
+        const auto uv = ev.CreateUnitVector();
+        REQUIRE(uv[0] == (3.0 / 13.0));
+        REQUIRE(uv[2] == (12.0 / 13.0));
+      }
+    }
+
+    WHEN("I use bad indices or divide by 0") {
+      THEN("The dynamic vector's exceptions are thrown") {
+        REQUIRE_THROWS_WITH(ev.at(3), "Index 3 is not valid for this EuclideanVector object");
+        REQUIRE_THROWS_WITH(ev / 0, "Invalid vector division by 0");
+        REQUIRE_THROWS_WITH(Vec3().CreateUnitVector(), "EuclideanVector with euclidean normal"
+                                                       " of 0 does not have a unit vector");
+      }
+    }
+
+    WHEN("I write it to a stream") {
+      std::ostringstream buf;
+      buf << ev;
+      THEN("It looks like a EuclideanVector") { REQUIRE(buf.str() == "[3 4 12]"); }
+    }
+
+    WHEN("I convert it to a EuclideanVector and back") {
+      const auto dynamic = static_cast<EuclideanVector>(ev);
+      THEN("The magnitudes survive") {
+        const std::vector<double> values{3, 4, 12};
+        REQUIRE(dynamic == EuclideanVector(values.begin(), values.end()));
+        REQUIRE(Vec3(dynamic) == ev);
+      }
+    }
+  }
+
+  GIVEN("A EuclideanVector of the wrong size") {
+    EuclideanVector ev(4);
+    THEN("Converting it throws the dimension error") {
+      REQUIRE_THROWS_WITH(Vec3(ev), "Dimensions of LHS(3) and RHS(4) do not match");
+    }
+  }
+}
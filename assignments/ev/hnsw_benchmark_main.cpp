@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+#include "assignments/ev/hnsw_index.h"
+#include "assignments/ev/knn_search.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double SecondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// RandomBatch scatters size vectors around 32 random centres, which is closer to real
+// embeddings than uniform noise
+EuclideanVectorBatch RandomBatch(int size, int dimensions, std::mt19937& random) {
+  std::normal_distribution<double> normal(0, 1);
+  std::vector<std::vector<double>> centres(32, std::vector<double>(dimensions));
+  for (auto& centre : centres) {
+    for (auto& x : centre) {
+      x = 3 * normal(random);
+    }
+  }
+  EuclideanVectorBatch ret(size, dimensions);
+  for (int i = 0; i < size; i++) {
+    const auto& centre = centres[random() % centres.size()];
+    const auto v = ret[i];
+    for (int j = 0; j < dimensions; j++) {
+      v[j] = centre[j] + normal(random);
+    }
+  }
+  return ret;
+}
+
+// ParseCount reads a positive count of at most seven digits, rejecting anything else
+bool ParseCount(const std::string& arg, int& count) {
+  if (arg.empty() || arg.size() > 7 ||
+      !std::all_of(arg.begin(), arg.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+    return false;
+  }
+  count = std::stoi(arg);
+  return count > 0;
+}
+
+}  // namespace
+
+// hnsw_benchmark measures HnswIndex recall and latency against BruteForceKnn on random
+// clustered vectors. Optional arguments are the corpus size, the dimension, the number of
+// queries and k, which default to 20000, 64, 500 and 10. Searches run one query at a time on
+// one thread, so the times are latencies. k may not exceed the corpus size.
+int main(int argc, char* argv[]) {
+  int counts[] = {20000, 64, 500, 10};
+  bool ok = argc <= 5;
+  for (int i = 1; ok && i < argc; i++) {
+    ok = ParseCount(static_cast<std::string>(argv[i]), counts[i - 1]);
+  }
+  if (!ok || counts[3] > counts[0]) {
+    std::cerr << "usage: " << argv[0] << " [size [dimensions [num_queries [k]]]]\n";
+    return 1;
+  }
+  const int size = counts[0];
+  const int dimensions = counts[1];
+  const int num_queries = counts[2];
+  const auto k = static_cast<std::size_t>(counts[3]);
+
+  std::mt19937 random(6771);
+  const auto corpus = RandomBatch(size, dimensions, random);
+  const auto queries = RandomBatch(num_queries, dimensions, random);
+  std::vector<EuclideanVector> query_vectors;
+  for (int q = 0; q < num_queries; q++) {
+    query_vectors.push_back(static_cast<EuclideanVector>(queries[q]));
+  }
+
+  auto start = Clock::now();
+  const BruteForceKnn exact(corpus, KnnMetric::kEuclidean);
+  std::vector<std::vector<Neighbour>> truth;
+  for (const auto& query : query_vectors) {
+    truth.push_back(exact.Search(query, k));
+  }
+  const double exact_us = SecondsSince(start) * 1e6 / num_queries;
+
+  start = Clock::now();
+  HnswIndex index(dimensions, KnnMetric::kEuclidean);
+  index.Add(corpus);
+  const double build_s = SecondsSince(start);
+
+  std::cout << size << " vectors, " << dimensions << " dimensions, " << num_queries
+            << " queries, k = " << k << "\n"
+            << "brute force: " << std::fixed << std::setprecision(1) << exact_us
+            << " us/query\n"
+            << "hnsw build:  " << std::setprecision(2) << build_s << " s (m = "
+            << index.options().m << ", ef_construction = " << index.options().ef_construction
+            << ")\n\n"
+            << "    ef    recall  us/query   speedup\n";
+
+  for (const std::size_t ef : {10, 20, 40, 80, 160, 320}) {
+    start = Clock::now();
+    std::size_t hits = 0;
+    for (int q = 0; q < num_queries; q++) {
+      const auto found = index.Search(query_vectors[q], k, ef);
+      for (const auto& n : truth[q]) {
+        for (const auto& f : found) {
+          hits += f.index == n.index;
+        }
+      }
+    }
+    const double us = SecondsSince(start) * 1e6 / num_queries;
+    std::cout << std::setw(6) << ef << std::setw(10) << std::setprecision(4)
+              << static_cast<double>(hits) / (truth.size() * k) << std::setw(10)
+              << std::setprecision(1) << us << std::setw(10) << exact_us / us << "\n";
+  }
+  return 0;
+}
@@ -0,0 +1,441 @@
+#include "assignments/ev/hnsw_index.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <queue>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+#include "assignments/ev/knn_search.h"
+#include "assignments/ev/vector_kernels.h"
+
+namespace {
+
+const char kMagic[8] = {'E', 'V', 'H', 'N', 'S', 'W', '0', '1'};
+
+bool Closer(const Neighbour& a, const Neighbour& b) noexcept {
+  return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+}
+
+bool Further(const Neighbour& a, const Neighbour& b) noexcept {
+  return Closer(b, a);
+}
+
+// VisitMarks records which vectors a layer search has reached. Each search takes a new epoch
+// rather than clearing the marks, so concurrent searches each keep one array per thread.
+class VisitMarks {
+ public:
+  static VisitMarks& ForThread() {
+    thread_local VisitMarks marks;
+    return marks;
+  }
+
+  void Begin(std::size_t size) {
+    if (marks_.size() < size) {
+      marks_.resize(size, 0);
+    }
+    if (++epoch_ == 0) {
+      std::fill(marks_.begin(), marks_.end(), 0);
+      epoch_ = 1;
+    }
+  }
+
+  // Visit marks i and returns whether it was unmarked
+  bool Visit(int i) noexcept {
+    if (marks_[i] == epoch_) {
+      return false;
+    }
+    marks_[i] = epoch_;
+    return true;
+  }
+
+ private:
+  std::vector<std::uint32_t> marks_;
+  std::uint32_t epoch_ = 0;
+};
+
+template <typename T>
+void Write(std::ostream& os, const T& value) {
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Expect throws the error for a stream that is not a saved index unless ok
+void Expect(bool ok) {
+  if (!ok) {
+    throw EuclideanVectorError("Stream does not hold a saved HnswIndex");
+  }
+}
+
+template <typename T>
+T Read(std::istream& is) {
+  T value{};
+  Expect(static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(value))));
+  return value;
+}
+
+// kMostReserved caps how many values ReadValues sets aside room for before it has read them
+const std::size_t kMostReserved = 1 << 16;
+
+// ReadValues appends count values from is to out. count comes from the stream itself, so out
+// grows with what is actually read: a stream claiming more than it holds fails when it runs
+// out instead of after allocating for the claim.
+template <typename T, typename U>
+void ReadValues(std::istream& is, std::size_t count, std::vector<U>& out) {
+  out.reserve(out.size() + std::min(count, kMostReserved));
+  for (std::size_t i = 0; i < count; ++i) {
+    out.push_back(Read<T>(is));
+  }
+}
+
+bool ValidOptions(const HnswOptions& options) {
+  return options.m >= 2 && options.ef_construction >= 1 && options.ef_search >= 1;
+}
+
+}  // namespace
+
+/* constructors */
+HnswIndex::HnswIndex(int dimensions, KnnMetric metric, HnswOptions options)
+  : dimensions_(dimensions), metric_(metric), options_(options), random_(options.seed) {
+  if (!ValidOptions(options_)) {
+    throw EuclideanVectorError("HnswIndex needs m of at least 2 and ef of at least 1");
+  }
+}
+
+// The stream is checked as it is read, so that a corrupt or hostile one throws instead of
+// leaving the index with links or layers a search would follow out of bounds
+HnswIndex::HnswIndex(std::istream& is) {
+  char magic[sizeof(kMagic)];
+  Expect(is.read(magic, sizeof(magic)) && std::equal(magic, magic + sizeof(magic), kMagic));
+  dimensions_ = Read<std::int32_t>(is);
+  const auto metric = Read<std::int32_t>(is);
+  Expect(metric == static_cast<std::int32_t>(KnnMetric::kEuclidean) ||
+         metric == static_cast<std::int32_t>(KnnMetric::kCosine));
+  metric_ = static_cast<KnnMetric>(metric);
+  options_.m = Read<std::int32_t>(is);
+  options_.ef_construction = Read<std::int32_t>(is);
+  options_.ef_search = Read<std::int32_t>(is);
+  options_.seed = Read<std::uint64_t>(is);
+  Expect(ValidOptions(options_));
+  const auto size = Read<std::int32_t>(is);
+  entry_ = Read<std::int32_t>(is);
+  top_layer_ = Read<std::int32_t>(is);
+  Expect(dimensions_ >= 0 && size >= 0);
+  // an empty index has no entry point; otherwise the entry point is on the top layer
+  Expect(size == 0 ? entry_ == -1 && top_layer_ == -1
+                   : entry_ >= 0 && entry_ < size && top_layer_ >= 0);
+
+  try {
+    ReadValues<double>(is, static_cast<std::size_t>(size) * dimensions_, vectors_);
+    links_.reserve(std::min(static_cast<std::size_t>(size), kMostReserved));
+    for (int i = 0; i < size; i++) {
+      const auto num_layers = Read<std::int32_t>(is);
+      Expect(num_layers >= 1 && num_layers - 1 <= top_layer_);
+      auto& layers = links_.emplace_back();
+      for (int layer = 0; layer < num_layers; ++layer) {
+        const auto num_links = Read<std::int32_t>(is);
+        Expect(num_links >= 0 && num_links <= (layer == 0 ? 2 : 1) * std::int64_t{options_.m});
+        ReadValues<std::int32_t>(is, num_links, layers.emplace_back());
+      }
+    }
+  } catch (const std::bad_alloc&) {
+    // a stream too large to hold is reported like any other unusable one
+    Expect(false);
+  }
+  if (size > 0) {
+    Expect(top_layer_ < static_cast<int>(links_[entry_].size()));
+  }
+  // a link on layer L must lead to a vector that is on layer L too
+  for (const auto& layers : links_) {
+    for (std::size_t layer = 0; layer < layers.size(); ++layer) {
+      for (const int link : layers[layer]) {
+        Expect(link >= 0 && link < size && links_[link].size() > layer);
+      }
+    }
+  }
+
+  for (int i = 0; i < size; i++) {
+    squared_norms_.push_back(Kernels().sum_of_squares(VectorAt(i), dimensions_));
+  }
+  // vectors added after loading draw their levels from a fresh seed
+  random_.seed(options_.seed + size);
+}
+
+HnswIndex HnswIndex::Load(std::istream& is) {
+  return HnswIndex(is);
+}
+
+/* insertion */
+int HnswIndex::Add(const EuclideanVector& v) {
+  CheckQuery(v);
+  const auto stored = metric_ == KnnMetric::kCosine ? v.CreateUnitVector() : v;
+
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  const int id = static_cast<int>(links_.size());
+  vectors_.insert(vectors_.end(), stored.data(), stored.data() + dimensions_);
+  squared_norms_.push_back(Kernels().sum_of_squares(stored.data(), dimensions_));
+  const int level = RandomLevel();
+  links_.emplace_back(level + 1);
+  if (entry_ < 0) {
+    entry_ = id;
+    top_layer_ = level;
+    return id;
+  }
+
+  const auto* query = VectorAt(id);
+  const auto squared_norm = squared_norms_[id];
+  std::vector<Neighbour> entries{{entry_, Distance(query, squared_norm, entry_)}};
+  for (int layer = top_layer_; layer > level; --layer) {
+    entries = SearchLayer(query, squared_norm, entries, 1, layer);
+  }
+  for (int layer = std::min(level, top_layer_); layer >= 0; --layer) {
+    auto found = SearchLayer(query, squared_norm, entries, options_.ef_construction, layer);
+    Link(id, layer, SelectNeighbours(found, options_.m));
+    entries = std::move(found);
+  }
+  if (level > top_layer_) {
+    entry_ = id;
+    top_layer_ = level;
+  }
+  return id;
+}
+
+void HnswIndex::Add(const EuclideanVectorBatch& batch) {
+  for (int i = 0; i < batch.size(); i++) {
+    Add(static_cast<EuclideanVector>(batch[i]));
+  }
+}
+
+// Link gives node its links on layer and links each neighbour back, pruning any neighbour that
+// ends up with more links than the layer allows
+void HnswIndex::Link(int node, int layer, std::vector<int> neighbours) {
+  const std::size_t most = layer == 0 ? 2 * options_.m : options_.m;
+  for (const int other : neighbours) {
+    auto& theirs = links_[other][layer];
+    if (theirs.size() < most) {
+      theirs.push_back(node);
+      continue;
+    }
+    std::vector<Neighbour> candidates{{node, Distance(VectorAt(other), squared_norms_[other],
+                                                      node)}};
+    for (const int link : theirs) {
+      candidates.push_back({link, Distance(VectorAt(other), squared_norms_[other], link)});
+    }
+    std::sort(candidates.begin(), candidates.end(), Closer);
+    theirs = SelectNeighbours(candidates, most);
+  }
+  links_[node][layer] = std::move(neighbours);
+}
+
+// SelectNeighbours picks up to m of candidates, which are sorted nearest first. A candidate is
+// skipped if it is nearer to one already picked than to the query, so links fan out in
+// different directions instead of bunching up inside one cluster.
+std::vector<int> HnswIndex::SelectNeighbours(const std::vector<Neighbour>& candidates,
+                                             std::size_t m) const {
+  std::vector<int> ret;
+  for (const auto& candidate : candidates) {
+    if (ret.size() >= m) {
+      break;
+    }
+    const auto* vector = VectorAt(candidate.index);
+    const auto squared_norm = squared_norms_[candidate.index];
+    const bool diverse = std::none_of(ret.begin(), ret.end(), [&](int picked) {
+      return Distance(vector, squared_norm, picked) < candidate.distance;
+    });
+    if (diverse) {
+      ret.push_back(candidate.index);
+    }
+  }
+  return ret;
+}
+
+int HnswIndex::RandomLevel() {
+  std::uniform_real_distribution<double> uniform(0, 1);
+  const double scale = 1 / std::log(static_cast<double>(options_.m));
+  return static_cast<int>(-std::log(1 - uniform(random_)) * scale);
+}
+
+/* search */
+std::vector<Neighbour>
+HnswIndex::Search(const EuclideanVector& query, std::size_t k, std::size_t ef) const {
+  CheckQuery(query);
+  const auto prepared = metric_ == KnnMetric::kCosine ? query.CreateUnitVector() : query;
+  const auto squared_norm = Kernels().sum_of_squares(prepared.data(), dimensions_);
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return SearchUnlocked(prepared.data(), squared_norm, k, ef);
+}
+
+std::vector<std::vector<Neighbour>> HnswIndex::Search(const EuclideanVectorBatch& queries,
+                                                      std::size_t k,
+                                                      std::size_t ef,
+                                                      std::size_t num_threads) const {
+  if (queries.GetNumDimensions() != dimensions_) {
+    throw euclideanDimensionError(dimensions_, queries.GetNumDimensions());
+  }
+  auto rows = queries.WithLayout(BatchLayout::kRowMajor);
+  if (metric_ == KnnMetric::kCosine) {
+    rows.NormaliseAll();
+  }
+  const auto squared_norms = rows.SquaredNorms();
+
+  std::vector<std::vector<Neighbour>> ret(rows.size());
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  num_threads = std::min<std::size_t>(std::max<std::size_t>(num_threads, 1),
+                                      std::max(rows.size(), 1));
+
+  // the workers search under the shared lock this thread holds until they are joined
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  std::atomic<int> next{0};
+  auto work = [&]() {
+    for (int q = next++; q < rows.size(); q = next++) {
+      const auto* query = rows.data() + q * rows.leading_dimension();
+      ret[q] = SearchUnlocked(query, squared_norms[q], k, ef);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return ret;
+}
+
+std::vector<Neighbour> HnswIndex::SearchUnlocked(const double* query,
+                                                 double squared_norm,
+                                                 std::size_t k,
+                                                 std::size_t ef) const {
+  if (entry_ < 0 || k == 0) {
+    return {};
+  }
+  ef = std::max<std::size_t>(ef == 0 ? options_.ef_search : ef, k);
+  std::vector<Neighbour> entries{{entry_, Distance(query, squared_norm, entry_)}};
+  for (int layer = top_layer_; layer > 0; --layer) {
+    entries = SearchLayer(query, squared_norm, entries, 1, layer);
+  }
+  auto ret = SearchLayer(query, squared_norm, entries, ef, 0);
+  ret.resize(std::min(k, ret.size()));
+  if (metric_ == KnnMetric::kEuclidean) {
+    for (auto& n : ret) {
+      n.distance = std::sqrt(n.distance);
+    }
+  }
+  return ret;
+}
+
+// SearchLayer is a best-first search of one layer from entries, keeping the ef nearest vectors
+// it meets and stopping once the nearest unexplored one is further than all of them. The
+// result is sorted nearest first.
+std::vector<Neighbour> HnswIndex::SearchLayer(const double* query,
+                                              double squared_norm,
+                                              const std::vector<Neighbour>& entries,
+                                              std::size_t ef,
+                                              int layer) const {
+  auto& visited = VisitMarks::ForThread();
+  visited.Begin(links_.size());
+  // candidates has the nearest unexplored vector on top, found the furthest kept one
+  std::priority_queue<Neighbour, std::vector<Neighbour>, decltype(&Further)> candidates(Further);
+  std::priority_queue<Neighbour, std::vector<Neighbour>, decltype(&Closer)> found(Closer);
+  for (const auto& entry : entries) {
+    if (visited.Visit(entry.index)) {
+      candidates.push(entry);
+      found.push(entry);
+    }
+  }
+  while (found.size() > ef) {
+    found.pop();
+  }
+
+  while (!candidates.empty()) {
+    const auto nearest = candidates.top();
+    if (found.size() >= ef && Closer(found.top(), nearest)) {
+      break;
+    }
+    candidates.pop();
+    for (const int link : links_[nearest.index][layer]) {
+      if (!visited.Visit(link)) {
+        continue;
+      }
+      const Neighbour next{link, Distance(query, squared_norm, link)};
+      if (found.size() < ef || Closer(next, found.top())) {
+        candidates.push(next);
+        found.push(next);
+        if (found.size() > ef) {
+          found.pop();
+        }
+      }
+    }
+  }
+
+  std::vector<Neighbour> ret(found.size());
+  for (auto it = ret.rbegin(); it != ret.rend(); ++it) {
+    *it = found.top();
+    found.pop();
+  }
+  return ret;
+}
+
+/* serialisation */
+void HnswIndex::Save(std::ostream& os) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  os.write(kMagic, sizeof(kMagic));
+  Write<std::int32_t>(os, dimensions_);
+  Write<std::int32_t>(os, static_cast<std::int32_t>(metric_));
+  Write<std::int32_t>(os, options_.m);
+  Write<std::int32_t>(os, options_.ef_construction);
+  Write<std::int32_t>(os, options_.ef_search);
+  Write<std::uint64_t>(os, options_.seed);
+  Write<std::int32_t>(os, static_cast<std::int32_t>(links_.size()));
+  Write<std::int32_t>(os, entry_);
+  Write<std::int32_t>(os, top_layer_);
+  os.write(reinterpret_cast<const char*>(vectors_.data()),
+           static_cast<std::streamsize>(vectors_.size() * sizeof(double)));
+  for (const auto& layers : links_) {
+    Write<std::int32_t>(os, static_cast<std::int32_t>(layers.size()));
+    for (const auto& links : layers) {
+      Write<std::int32_t>(os, static_cast<std::int32_t>(links.size()));
+      for (const int link : links) {
+        Write<std::int32_t>(os, link);
+      }
+    }
+  }
+}
+
+/* methods */
+int HnswIndex::size() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  return static_cast<int>(links_.size());
+}
+
+void HnswIndex::CheckQuery(const EuclideanVector& v) const {
+  if (v.GetNumDimensions() != dimensions_) {
+    throw euclideanDimensionError(dimensions_, v.GetNumDimensions());
+  }
+}
+
+const double* HnswIndex::VectorAt(int i) const noexcept {
+  return vectors_.data() + static_cast<std::size_t>(i) * dimensions_;
+}
+
+// Distance is the squared euclidean distance, or the cosine distance, from query to vector i
+double HnswIndex::Distance(const double* query, double squared_norm, int i) const noexcept {
+  const auto dot = Kernels().dot(query, VectorAt(i), dimensions_);
+  const auto distance = metric_ == KnnMetric::kCosine
+                            ? 1 - dot
+                            : squared_norm + squared_norms_[i] - 2 * dot;
+  return std::max(distance, 0.0);
+}
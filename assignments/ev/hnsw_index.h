@@ -0,0 +1,102 @@
+#ifndef ASSIGNMENTS_EV_HNSW_INDEX_H_
+#define ASSIGNMENTS_EV_HNSW_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <random>
+#include <shared_mutex>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+#include "assignments/ev/knn_search.h"
+
+// HnswOptions are the knobs of an HnswIndex. m is how many links a vector keeps on each layer
+// above the bottom one, which keeps 2 * m; more links raise recall at the cost of memory and
+// insertion time. ef_construction is how many candidates an insertion weighs up when picking
+// links, and ef_search how many a search keeps unless it is given its own ef.
+struct HnswOptions {
+  int m = 16;
+  int ef_construction = 200;
+  int ef_search = 64;
+  std::uint64_t seed = 6771;
+};
+
+// HnswIndex is an approximate nearest neighbour index over EuclideanVectors, a hierarchical
+// navigable small world graph (Malkov and Yashunin). Each vector is linked to a few near
+// neighbours on the bottom layer and, with exponentially falling probability, on the sparser
+// layers above it; a search walks greedily down the layers and then explores the bottom one.
+// Larger ef finds more of the true neighbours and takes longer, which BruteForceKnn with the
+// same metric can measure.
+//
+// Vectors are numbered from 0 in the order they are added. Searches hold a shared lock and
+// run concurrently with each other; Add holds it exclusively, so vectors can keep being added
+// while the index is in use. Distances are worked out as BruteForceKnn works them out, so the
+// two agree, to rounding, on every neighbour they both find.
+class HnswIndex {
+ public:
+  HnswIndex(int dimensions, KnnMetric metric, HnswOptions options = {});
+  HnswIndex(const HnswIndex&) = delete;
+  HnswIndex& operator=(const HnswIndex&) = delete;
+
+  // Add inserts v and returns its index. It throws the EuclideanVector dimension error for a
+  // vector of the wrong dimension, and with kCosine the unit vector error for a zero one.
+  int Add(const EuclideanVector& v);
+  void Add(const EuclideanVectorBatch& batch);
+
+  // Search returns up to k approximate nearest neighbours of query, nearest first, considering
+  // max(k, ef) candidates on the bottom layer (options().ef_search when ef is 0). Queries are
+  // checked as Add checks vectors.
+  std::vector<Neighbour>
+  Search(const EuclideanVector& query, std::size_t k, std::size_t ef = 0) const;
+
+  // Search answers every query in queries, using num_threads threads (0 for one per hardware
+  // thread) including the calling thread
+  std::vector<std::vector<Neighbour>> Search(const EuclideanVectorBatch& queries,
+                                             std::size_t k,
+                                             std::size_t ef = 0,
+                                             std::size_t num_threads = 0) const;
+
+  // Save writes the index to os in a binary format for this machine's byte order, which Load
+  // reads back. Load throws a EuclideanVectorError if is does not hold a saved index. A loaded
+  // index searches exactly as the saved one did; vectors added to it may get different layers.
+  void Save(std::ostream& os) const;
+  static HnswIndex Load(std::istream& is);
+
+  int size() const;
+  int GetNumDimensions() const noexcept { return dimensions_; }
+  KnnMetric metric() const noexcept { return metric_; }
+  const HnswOptions& options() const noexcept { return options_; }
+
+ private:
+  explicit HnswIndex(std::istream& is);
+
+  const double* VectorAt(int i) const noexcept;
+  double Distance(const double* query, double squared_norm, int i) const noexcept;
+  std::vector<Neighbour> SearchLayer(const double* query,
+                                     double squared_norm,
+                                     const std::vector<Neighbour>& entries,
+                                     std::size_t ef,
+                                     int layer) const;
+  std::vector<Neighbour>
+  SearchUnlocked(const double* query, double squared_norm, std::size_t k, std::size_t ef) const;
+  std::vector<int> SelectNeighbours(const std::vector<Neighbour>& candidates,
+                                    std::size_t m) const;
+  void Link(int node, int layer, std::vector<int> neighbours);
+  int RandomLevel();
+  void CheckQuery(const EuclideanVector& v) const;
+
+  int dimensions_;
+  KnnMetric metric_;
+  HnswOptions options_;
+  std::vector<double> vectors_;  // row-major, and unit vectors for kCosine
+  std::vector<double> squared_norms_;
+  std::vector<std::vector<std::vector<int>>> links_;  // links_[vector][layer]
+  int entry_ = -1;
+  int top_layer_ = -1;
+  std::mt19937_64 random_;
+  mutable std::shared_mutex mutex_;
+};
+
+#endif  // ASSIGNMENTS_EV_HNSW_INDEX_H_
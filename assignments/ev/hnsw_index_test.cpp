@@ -0,0 +1,257 @@
+/*
+
+   Overall approach:
+    - Measure recall against BruteForceKnn on clustered random vectors, for both metrics
+    - Check that the distances reported agree with the brute force ones
+    - Check that vectors added after searching has started can be found
+    - Search from several threads while another thread keeps adding vectors
+    - Round trip an index through Save and Load and compare every search result
+    - Check the errors: bad options, dimensions, zero vectors and corrupt streams
+
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+#include "assignments/ev/hnsw_index.h"
+#include "assignments/ev/knn_search.h"
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+namespace {
+
+// Recall is the fraction of the true neighbours found
+double Recall(const std::vector<std::vector<Neighbour>>& found,
+              const std::vector<std::vector<Neighbour>>& truth) {
+  std::size_t hits = 0, total = 0;
+  for (std::size_t q = 0; q < truth.size(); q++) {
+    for (const auto& n : truth[q]) {
+      hits += std::any_of(found[q].begin(), found[q].end(),
+                          [&](const Neighbour& f) { return f.index == n.index; });
+    }
+    total += truth[q].size();
+  }
+  return static_cast<double>(hits) / total;
+}
+
+}  // namespace
+
+SCENARIO("HnswIndex finds nearly all the true nearest neighbours") {
+  const auto corpus = ClusteredVectors(2000, 16, 1);
+  const auto queries = EuclideanVectorBatch::FromVectors(ClusteredVectors(100, 16, 2));
+
+  for (const auto metric : {KnnMetric::kEuclidean, KnnMetric::kCosine}) {
+    GIVEN("An index of 2000 vectors with metric " + std::to_string(static_cast<int>(metric))) {
+      HnswIndex index(16, metric);
+      for (const auto& v : corpus) {
+        index.Add(v);
+      }
+      const BruteForceKnn exact(EuclideanVectorBatch::FromVectors(corpus), metric);
+      const auto truth = exact.Search(queries, 10);
+      REQUIRE(index.size() == 2000);
+
+      WHEN("I search with the default ef and a larger one") {
+        const auto found = index.Search(queries, 10);
+        const auto wider = index.Search(queries, 10, 200);
+
+        THEN("Recall is high, and does not fall as ef grows") {
+          REQUIRE(Recall(found, truth) >= 0.9);
+          REQUIRE(Recall(wider, truth) >= 0.98);
+          REQUIRE(Recall(wider, truth) >= Recall(found, truth));
+        }
+
+        THEN("Neighbours are sorted and their distances match the exact ones") {
+          const auto everything = exact.Search(queries, 2000);
+          for (int q = 0; q < queries.size(); q++) {
+            REQUIRE(found[q].size() == 10);
+            REQUIRE(std::is_sorted(found[q].begin(), found[q].end(),
+                                   [](const Neighbour& a, const Neighbour& b) {
+                                     return a.distance < b.distance;
+                                   }));
+            for (const auto& n : found[q]) {
+              const auto match = std::find_if(
+                  everything[q].begin(), everything[q].end(),
+                  [&](const Neighbour& e) { return e.index == n.index; });
+              REQUIRE(n.distance == Approx(match->distance).margin(1e-9));
+            }
+          }
+        }
+
+        THEN("Single searches and any number of threads agree with the batch") {
+          REQUIRE(index.Search(queries, 10, 0, 1) == found);
+          REQUIRE(index.Search(static_cast<EuclideanVector>(queries[7]), 10) == found[7]);
+        }
+      }
+
+      WHEN("I search for a vector in the index") {
+        const auto found = index.Search(corpus[1234], 1);
+        THEN("It finds that vector") {
+          REQUIRE(found.size() == 1);
+          REQUIRE(found[0].index == 1234);
+          REQUIRE(found[0].distance == Approx(0).margin(1e-6));
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("HnswIndex grows while it is searched") {
+  GIVEN("A small index") {
+    const auto vectors = ClusteredVectors(1500, 8, 3);
+    HnswIndex index(8, KnnMetric::kEuclidean, HnswOptions{8, 100, 50, 1});
+    for (int i = 0; i < 500; i++) {
+      index.Add(vectors[i]);
+    }
+
+    WHEN("One thread adds the rest while others search") {
+      std::thread writer([&]() {
+        for (int i = 500; i < 1500; i++) {
+          index.Add(vectors[i]);
+        }
+      });
+      std::vector<std::thread> readers;
+      std::vector<int> misses(4, 0);
+      for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&, r]() {
+          for (int i = r; i < 500; i += 4) {
+            misses[r] += index.Search(vectors[i], 1).front().index != i;
+          }
+        });
+      }
+      writer.join();
+      for (auto& reader : readers) {
+        reader.join();
+      }
+
+      THEN("Searches kept working and every vector can be found") {
+        REQUIRE(index.size() == 1500);
+        int total = 0;
+        for (const int miss : misses) {
+          total += miss;
+        }
+        REQUIRE(total <= 5);
+        for (const int i : {0, 499, 500, 1000, 1499}) {
+          REQUIRE(index.Search(vectors[i], 1, 100).front().index == i);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Saving and loading a HnswIndex") {
+  GIVEN("An index") {
+    const auto vectors = ClusteredVectors(600, 12, 4);
+    HnswIndex index(12, KnnMetric::kCosine, HnswOptions{6, 50, 30, 9});
+    index.Add(EuclideanVectorBatch::FromVectors(vectors));
+    const auto queries = EuclideanVectorBatch::FromVectors(ClusteredVectors(20, 12, 5));
+
+    WHEN("I save it and load it back") {
+      std::stringstream buf;
+      index.Save(buf);
+      auto loaded = HnswIndex::Load(buf);
+
+      THEN("The copy is the same index") {
+        REQUIRE(loaded.size() == 600);
+        REQUIRE(loaded.GetNumDimensions() == 12);
+        REQUIRE(loaded.metric() == KnnMetric::kCosine);
+        REQUIRE(loaded.options().m == 6);
+        REQUIRE(loaded.options().ef_search == 30);
+        REQUIRE(loaded.Search(queries, 5) == index.Search(queries, 5));
+        REQUIRE(loaded.Search(queries, 5, 100) == index.Search(queries, 5, 100));
+      }
+
+      THEN("The copy can keep growing") {
+        const auto extra = ClusteredVectors(1, 12, 6).front();
+        REQUIRE(loaded.Add(extra) == 600);
+        REQUIRE(loaded.Search(extra, 1).front().index == 600);
+      }
+    }
+
+    WHEN("I load a stream that is not a saved index") {
+      std::stringstream garbage("not an index");
+      std::stringstream truncated;
+      index.Save(truncated);
+      truncated.str(truncated.str().substr(0, 100));
+      THEN("It throws") {
+        REQUIRE_THROWS_WITH(HnswIndex::Load(garbage), "Stream does not hold a saved HnswIndex");
+        REQUIRE_THROWS_WITH(HnswIndex::Load(truncated),
+                            "Stream does not hold a saved HnswIndex");
+      }
+    }
+
+    WHEN("I change single fields of a saved index") {
+      std::stringstream buf;
+      index.Save(buf);
+      const auto saved = buf.str();
+      // Patched loads saved with the 32 bit field at offset replaced by value
+      const auto patched = [&saved](std::size_t offset, std::int32_t value) {
+        auto bytes = saved;
+        bytes.replace(offset, sizeof(value), reinterpret_cast<const char*>(&value),
+                      sizeof(value));
+        std::stringstream is(bytes);
+        return HnswIndex::Load(is).size();
+      };
+      const std::size_t first_node = 48 + 600 * 12 * sizeof(double);
+
+      THEN("Fields a search or insertion would trip over are rejected") {
+        const std::string error = "Stream does not hold a saved HnswIndex";
+        REQUIRE(patched(16, 6) == 600);
+        REQUIRE(patched(16, 0x7fffffff) == 600);  // m so large that 2 * m overflows an int
+        REQUIRE_THROWS_WITH(patched(12, 7), error);  // metric
+        REQUIRE_THROWS_WITH(patched(16, 1), error);  // m
+        REQUIRE_THROWS_WITH(patched(20, 0), error);  // ef_construction
+        REQUIRE_THROWS_WITH(patched(44, 40), error);  // top layer
+        REQUIRE_THROWS_WITH(patched(44, -1), error);  // top layer
+        REQUIRE_THROWS_WITH(patched(8, 46341), error);  // dimensions past the end of the stream
+        REQUIRE_THROWS_WITH(patched(36, 0x7fffffff), error);  // size past the end of the stream
+        REQUIRE_THROWS_WITH(patched(40, 600), error);  // entry point
+        REQUIRE_THROWS_WITH(patched(first_node, -1), error);  // layer count
+        REQUIRE_THROWS_WITH(patched(first_node, 0), error);  // layer count
+        REQUIRE_THROWS_WITH(patched(first_node + 4, -5), error);  // link count
+        REQUIRE_THROWS_WITH(patched(first_node + 8, 600), error);  // link
+      }
+    }
+  }
+}
+
+SCENARIO("HnswIndex errors and edge cases") {
+  GIVEN("An empty index") {
+    HnswIndex index(3, KnnMetric::kCosine);
+    THEN("Searches find nothing") {
+      REQUIRE(index.Search(EuclideanVector(3, 1.0), 5).empty());
+      const std::vector<EuclideanVector> queries(2, EuclideanVector(3, 1.0));
+      const auto batch = EuclideanVectorBatch::FromVectors(queries, BatchLayout::kColumnMajor);
+      REQUIRE(index.Search(batch, 5) == std::vector<std::vector<Neighbour>>(2));
+    }
+
+    THEN("Wrong dimensions and zero vectors throw") {
+      REQUIRE_THROWS_WITH(index.Add(EuclideanVector(4, 1.0)),
+                          "Dimensions of LHS(3) and RHS(4) do not match");
+      REQUIRE_THROWS_WITH(index.Search(EuclideanVector(2, 1.0), 1),
+                          "Dimensions of LHS(3) and RHS(2) do not match");
+      REQUIRE_THROWS_WITH(index.Add(EuclideanVector(3)),
+                          "EuclideanVector with euclidean normal of 0 does not have a unit vector");
+      REQUIRE(index.size() == 0);
+    }
+
+    THEN("A search for 0 neighbours finds none") {
+      index.Add(EuclideanVector(3, 1.0));
+      REQUIRE(index.Search(EuclideanVector(3, 1.0), 0).empty());
+      REQUIRE(index.Search(EuclideanVector(3, 1.0), 4).size() == 1);
+    }
+  }
+
+  GIVEN("Options that cannot work") {
+    THEN("Construction throws") {
+      REQUIRE_THROWS_WITH(HnswIndex(3, KnnMetric::kEuclidean, HnswOptions{1, 10, 10, 0}),
+                          "HnswIndex needs m of at least 2 and ef of at least 1");
+    }
+  }
+}
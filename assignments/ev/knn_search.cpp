@@ -0,0 +1,155 @@
+#include "assignments/ev/knn_search.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+#include "assignments/ev/vector_kernels.h"
+
+namespace {
+
+// a shard of the corpus holds about this many bytes, aiming to stay in a core's L2 cache
+const std::size_t kShardBytes = 128 * 1024;
+
+bool Closer(const Neighbour& a, const Neighbour& b) noexcept {
+  return a.distance < b.distance || (a.distance == b.distance && a.index < b.index);
+}
+
+// BoundedHeap keeps the best k neighbours pushed into it, the worst of them on top
+class BoundedHeap {
+ public:
+  explicit BoundedHeap(std::size_t k) : k_(k) { heap_.reserve(k); }
+
+  void Push(const Neighbour& n) {
+    if (heap_.size() < k_) {
+      heap_.push_back(n);
+      std::push_heap(heap_.begin(), heap_.end(), Closer);
+    } else if (Closer(n, heap_.front())) {
+      std::pop_heap(heap_.begin(), heap_.end(), Closer);
+      heap_.back() = n;
+      std::push_heap(heap_.begin(), heap_.end(), Closer);
+    }
+  }
+
+  const std::vector<Neighbour>& contents() const noexcept { return heap_; }
+
+  // Sorted empties the heap into a vector, nearest first
+  std::vector<Neighbour> Sorted() {
+    std::sort_heap(heap_.begin(), heap_.end(), Closer);
+    return std::move(heap_);
+  }
+
+ private:
+  std::size_t k_;
+  std::vector<Neighbour> heap_;
+};
+
+}  // namespace
+
+BruteForceKnn::BruteForceKnn(const EuclideanVectorBatch& corpus, KnnMetric metric)
+  : corpus_(corpus.WithLayout(BatchLayout::kColumnMajor)), metric_(metric) {
+  if (metric_ == KnnMetric::kCosine) {
+    corpus_.NormaliseAll();
+  } else {
+    squared_norms_ = corpus_.SquaredNorms();
+  }
+  const auto fit = kShardBytes / (sizeof(double) * std::max(corpus_.GetNumDimensions(), 1));
+  shard_size_ = static_cast<int>(std::max<std::size_t>(fit / 8, 1) * 8);
+}
+
+std::vector<Neighbour> BruteForceKnn::Search(const EuclideanVector& query, std::size_t k) const {
+  if (query.GetNumDimensions() != GetNumDimensions()) {
+    throw euclideanDimensionError(GetNumDimensions(), query.GetNumDimensions());
+  }
+  EuclideanVectorBatch queries(1, GetNumDimensions());
+  queries.Set(0, query);
+  return std::move(Search(queries, k, 1).front());
+}
+
+std::vector<std::vector<Neighbour>> BruteForceKnn::Search(const EuclideanVectorBatch& queries,
+                                                          std::size_t k,
+                                                          std::size_t num_threads) const {
+  if (queries.GetNumDimensions() != GetNumDimensions()) {
+    throw euclideanDimensionError(GetNumDimensions(), queries.GetNumDimensions());
+  }
+  auto rows = queries.WithLayout(BatchLayout::kRowMajor);
+  std::vector<double> query_norms;
+  if (metric_ == KnnMetric::kCosine) {
+    rows.NormaliseAll();
+  } else {
+    query_norms = rows.SquaredNorms();
+  }
+
+  std::vector<std::vector<Neighbour>> ret(queries.size());
+  k = std::min<std::size_t>(k, size());
+  if (k == 0) {
+    return ret;
+  }
+
+  const auto& kernels = Kernels();
+  const int dimensions = GetNumDimensions();
+  const int num_shards = (size() + shard_size_ - 1) / shard_size_;
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  num_threads = std::min<std::size_t>(std::max<std::size_t>(num_threads, 1), num_shards);
+
+  // each thread keeps its own heap per query, so nothing is shared until the merge
+  const std::vector<BoundedHeap> empty(rows.size(), BoundedHeap(k));
+  std::vector<std::vector<BoundedHeap>> heaps(num_threads, empty);
+  std::atomic<int> next{0};
+  auto work = [&](std::size_t thread) {
+    std::vector<double> scores(shard_size_);
+    for (int shard = next++; shard < num_shards; shard = next++) {
+      const int first = shard * shard_size_;
+      const int width = std::min(shard_size_, size() - first);
+      for (int q = 0; q < rows.size(); q++) {
+        const auto* query = rows.data() + q * rows.leading_dimension();
+        std::fill_n(scores.begin(), width, 0.0);
+        for (int d = 0; d < dimensions; d++) {
+          kernels.axpy(scores.data(), query[d],
+                       corpus_.data() + d * corpus_.leading_dimension() + first, width);
+        }
+        auto& heap = heaps[thread][q];
+        for (int j = 0; j < width; j++) {
+          const double distance =
+              metric_ == KnnMetric::kCosine
+                  ? 1 - scores[j]
+                  : query_norms[q] + squared_norms_[first + j] - 2 * scores[j];
+          heap.Push({first + j, std::max(distance, 0.0)});
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(work, i);
+  }
+  work(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int q = 0; q < rows.size(); q++) {
+    auto& merged = heaps[0][q];
+    for (std::size_t t = 1; t < num_threads; ++t) {
+      for (const auto& n : heaps[t][q].contents()) {
+        merged.Push(n);
+      }
+    }
+    ret[q] = merged.Sorted();
+    if (metric_ == KnnMetric::kEuclidean) {
+      for (auto& n : ret[q]) {
+        n.distance = std::sqrt(n.distance);
+      }
+    }
+  }
+  return ret;
+}
@@ -0,0 +1,62 @@
+#ifndef ASSIGNMENTS_EV_KNN_SEARCH_H_
+#define ASSIGNMENTS_EV_KNN_SEARCH_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+
+// KnnMetric is how neighbours are ranked: by euclidean distance, or by cosine distance,
+// 1 - cos(angle), which ignores the vectors' lengths
+enum class KnnMetric { kEuclidean, kCosine };
+
+// Neighbour is a corpus vector found by a search: its position in the corpus and its distance
+// from the query
+struct Neighbour {
+  int index;
+  double distance;
+};
+
+inline bool operator==(const Neighbour& a, const Neighbour& b) noexcept {
+  return a.index == b.index && a.distance == b.distance;
+}
+
+// BruteForceKnn finds the exact k nearest neighbours of queries by measuring the distance to
+// every vector in a corpus. Neighbours come back nearest first, ties broken by corpus index, so
+// results are the same for any number of threads; it is the ground truth approximate indexes
+// are checked against.
+//
+// The corpus is copied into a column-major batch, normalised for kCosine, and split into
+// shards small enough to stay in cache. Threads take shards in turn and run every query against
+// each, scoring a shard with the axpy kernel and keeping a bounded heap of the best k per
+// query; the heaps are merged at the end. Euclidean distances come from
+// |q|^2 + |c|^2 - 2 q * c, so vectors closer together than about 1e-8 of their length apart
+// may be ranked in the wrong order.
+class BruteForceKnn {
+ public:
+  // A zero vector has no cosine distance, so with kCosine a corpus holding one throws as
+  // EuclideanVector::CreateUnitVector does
+  BruteForceKnn(const EuclideanVectorBatch& corpus, KnnMetric metric);
+
+  // Search returns the min(k, size()) nearest neighbours of query. A query of the wrong
+  // dimension throws the EuclideanVector dimension error, and with kCosine so does a zero one.
+  std::vector<Neighbour> Search(const EuclideanVector& query, std::size_t k) const;
+
+  // Search returns the nearest neighbours of every vector in queries, using num_threads threads
+  // (0 for one per hardware thread) including the calling thread
+  std::vector<std::vector<Neighbour>>
+  Search(const EuclideanVectorBatch& queries, std::size_t k, std::size_t num_threads = 0) const;
+
+  int size() const noexcept { return corpus_.size(); }
+  int GetNumDimensions() const noexcept { return corpus_.GetNumDimensions(); }
+  KnnMetric metric() const noexcept { return metric_; }
+
+ private:
+  EuclideanVectorBatch corpus_;
+  KnnMetric metric_;
+  std::vector<double> squared_norms_;
+  int shard_size_;
+};
+
+#endif  // ASSIGNMENTS_EV_KNN_SEARCH_H_
@@ -0,0 +1,147 @@
+/*
+
+   Overall approach:
+    - Compare every search against sorting the whole corpus by the distance EuclideanVector
+      itself computes
+    - Use a dimension large enough to split the corpus into several shards, and check every
+      thread count gives exactly the same neighbours
+    - Include duplicate corpus vectors to check ties are broken by index
+    - Check k larger than the corpus, k of 0 and the errors
+
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+#include "assignments/ev/knn_search.h"
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+namespace {
+
+double Distance(const EuclideanVector& a, const EuclideanVector& b, KnnMetric metric) {
+  if (metric == KnnMetric::kCosine) {
+    return 1 - a.CreateUnitVector() * b.CreateUnitVector();
+  }
+  const EuclideanVector difference = a - b;
+  return std::sqrt(difference * difference);
+}
+
+// Expected sorts the whole corpus by distance from query and keeps the first k
+std::vector<Neighbour> Expected(const std::vector<EuclideanVector>& corpus,
+                                const EuclideanVector& query,
+                                std::size_t k,
+                                KnnMetric metric) {
+  std::vector<Neighbour> all;
+  for (int i = 0; i < static_cast<int>(corpus.size()); i++) {
+    all.push_back({i, Distance(corpus[i], query, metric)});
+  }
+  std::stable_sort(all.begin(), all.end(), [](const Neighbour& a, const Neighbour& b) {
+    return a.distance < b.distance;
+  });
+  all.resize(std::min(k, all.size()));
+  return all;
+}
+
+}  // namespace
+
+SCENARIO("BruteForceKnn finds the exact nearest neighbours") {
+  for (const int dimensions : {5, 700}) {
+    auto corpus = WaveVectors(100, dimensions, 0.4, 0.25);
+    corpus[61] = corpus[17];
+    const auto queries = WaveVectors(9, dimensions, 3.1, 0.25);
+    const auto query_batch = EuclideanVectorBatch::FromVectors(queries);
+
+    for (const auto metric : {KnnMetric::kEuclidean, KnnMetric::kCosine}) {
+      GIVEN(std::to_string(dimensions) + " dimensions and metric " +
+            std::to_string(static_cast<int>(metric))) {
+        const BruteForceKnn knn(EuclideanVectorBatch::FromVectors(corpus), metric);
+        REQUIRE(knn.size() == 100);
+        REQUIRE(knn.GetNumDimensions() == dimensions);
+
+        WHEN("I search for the 10 nearest neighbours of each query") {
+          const auto found = knn.Search(query_batch, 10, 1);
+
+          THEN("They match a full sort of the corpus") {
+            REQUIRE(found.size() == 9);
+            for (int q = 0; q < 9; q++) {
+              const auto expected = Expected(corpus, queries[q], 10, metric);
+              REQUIRE(found[q].size() == 10);
+              for (int i = 0; i < 10; i++) {
+                REQUIRE(found[q][i].index == expected[i].index);
+                REQUIRE(found[q][i].distance == Approx(expected[i].distance).margin(1e-9));
+              }
+            }
+          }
+
+          THEN("Any number of threads and single searches give the same answer") {
+            REQUIRE(knn.Search(query_batch, 10, 4) == found);
+            REQUIRE(knn.Search(query_batch, 10) == found);
+            REQUIRE(knn.Search(queries[3], 10) == found[3]);
+          }
+        }
+
+        WHEN("I search near a duplicated vector") {
+          const auto found = knn.Search(corpus[17], 2);
+          THEN("Both copies are found, in index order") {
+            REQUIRE(found[0].index == 17);
+            REQUIRE(found[1].index == 61);
+            REQUIRE(found[0].distance == found[1].distance);
+            REQUIRE(found[0].distance == Approx(0).margin(1e-6));
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("BruteForceKnn edge cases and errors") {
+  const auto corpus = WaveVectors(4, 3, 0.0, 0.25);
+  const BruteForceKnn knn(EuclideanVectorBatch::FromVectors(corpus), KnnMetric::kEuclidean);
+
+  GIVEN("A corpus of 4 vectors") {
+    THEN("Asking for more neighbours than there are returns the whole corpus, in order") {
+      const auto found = knn.Search(corpus[0], 10);
+      REQUIRE(found.size() == 4);
+      REQUIRE(found.front().index == 0);
+      REQUIRE(std::is_sorted(found.begin(), found.end(),
+                             [](const Neighbour& a, const Neighbour& b) {
+                               return a.distance < b.distance;
+                             }));
+    }
+
+    THEN("Asking for none returns none") {
+      REQUIRE(knn.Search(corpus[0], 0).empty());
+      REQUIRE(knn.Search(EuclideanVectorBatch::FromVectors(corpus), 0).size() == 4);
+    }
+
+    THEN("Queries of the wrong dimension throw") {
+      REQUIRE_THROWS_WITH(knn.Search(EuclideanVector(4), 1),
+                          "Dimensions of LHS(3) and RHS(4) do not match");
+      REQUIRE_THROWS_WITH(knn.Search(EuclideanVectorBatch(1, 2), 1),
+                          "Dimensions of LHS(3) and RHS(2) do not match");
+    }
+  }
+
+  GIVEN("Zero vectors and the cosine metric") {
+    auto with_zero = corpus;
+    with_zero[2] = EuclideanVector(3);
+    const BruteForceKnn cosine(EuclideanVectorBatch::FromVectors(corpus), KnnMetric::kCosine);
+    THEN("They have no unit vector, so they throw") {
+      REQUIRE_THROWS_WITH(
+          BruteForceKnn(EuclideanVectorBatch::FromVectors(with_zero), KnnMetric::kCosine),
+          "EuclideanVector with euclidean normal of 0 does not have a unit vector");
+      REQUIRE_THROWS_WITH(cosine.Search(EuclideanVector(3), 1),
+                          "EuclideanVector with euclidean normal of 0 does not have a unit vector");
+    }
+  }
+
+  GIVEN("An empty corpus") {
+    const BruteForceKnn empty(EuclideanVectorBatch(0, 3), KnnMetric::kEuclidean);
+    THEN("Searches find nothing") { REQUIRE(empty.Search(corpus[0], 5).empty()); }
+  }
+}
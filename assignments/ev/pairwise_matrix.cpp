@@ -0,0 +1,111 @@
+#include "assignments/ev/pairwise_matrix.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+#include "assignments/ev/vector_kernels.h"
+
+namespace {
+
+// a tile of b holds about this many bytes, aiming to stay in a core's L2 cache
+const std::size_t kTileBytes = 128 * 1024;
+// rows of a handed to a thread at once
+const int kRowsPerBlock = 16;
+
+// TileColumns is how many vectors of b go in a tile, a whole number of cache lines of each
+// column unless b is smaller than that
+int TileColumns(int dimensions, int size) {
+  const auto fit = kTileBytes / (sizeof(double) * std::max(dimensions, 1));
+  const auto lines = std::max<std::size_t>(fit / 8, 1) * 8;
+  return static_cast<int>(std::min<std::size_t>(lines, size));
+}
+
+// InLayout returns batch if it is already in layout and otherwise a copy kept in storage
+const EuclideanVectorBatch& InLayout(const EuclideanVectorBatch& batch,
+                                     BatchLayout layout,
+                                     std::optional<EuclideanVectorBatch>& storage) {
+  if (batch.layout() == layout) {
+    return batch;
+  }
+  storage.emplace(batch.WithLayout(layout));
+  return *storage;
+}
+
+}  // namespace
+
+PairwiseMatrix ComputePairwise(const EuclideanVectorBatch& a,
+                               const EuclideanVectorBatch& b,
+                               PairwiseMetric metric,
+                               std::size_t num_threads) {
+  if (a.GetNumDimensions() != b.GetNumDimensions()) {
+    throw euclideanDimensionError(a.GetNumDimensions(), b.GetNumDimensions());
+  }
+  PairwiseMatrix ret(a.size(), b.size());
+  if (a.size() == 0 || b.size() == 0) {
+    return ret;
+  }
+
+  std::optional<EuclideanVectorBatch> row_storage, column_storage;
+  const auto& rows = InLayout(a, BatchLayout::kRowMajor, row_storage);
+  const auto& columns = InLayout(b, BatchLayout::kColumnMajor, column_storage);
+  std::vector<double> row_norms, column_norms;
+  if (metric != PairwiseMetric::kDotProduct) {
+    row_norms = rows.SquaredNorms();
+    column_norms = columns.SquaredNorms();
+  }
+
+  const auto& kernels = Kernels();
+  const int dimensions = a.GetNumDimensions();
+  const int tile = TileColumns(dimensions, b.size());
+  const int num_blocks = (a.size() + kRowsPerBlock - 1) / kRowsPerBlock;
+
+  std::atomic<int> next{0};
+  auto work = [&]() {
+    for (int block = next++; block < num_blocks; block = next++) {
+      const int first = block * kRowsPerBlock;
+      const int last = std::min(first + kRowsPerBlock, a.size());
+      for (int j = 0; j < b.size(); j += tile) {
+        const int width = std::min(tile, b.size() - j);
+        for (int i = first; i < last; i++) {
+          const auto* row = rows.data() + i * rows.leading_dimension();
+          auto* out = ret.data() + static_cast<std::size_t>(i) * b.size() + j;
+          for (int k = 0; k < dimensions; k++) {
+            const auto* column = columns.data() + k * columns.leading_dimension() + j;
+            kernels.axpy(out, row[k], column, width);
+          }
+        }
+      }
+      if (metric == PairwiseMetric::kDotProduct) {
+        continue;
+      }
+      for (int i = first; i < last; i++) {
+        auto* out = ret.data() + static_cast<std::size_t>(i) * b.size();
+        for (int j = 0; j < b.size(); j++) {
+          const auto squared = std::max(row_norms[i] + column_norms[j] - 2 * out[j], 0.0);
+          out[j] = metric == PairwiseMetric::kEuclidean ? std::sqrt(squared) : squared;
+        }
+      }
+    }
+  };
+
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  num_threads = std::min<std::size_t>(std::max<std::size_t>(num_threads, 1), num_blocks);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < num_threads; ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return ret;
+}
@@ -0,0 +1,52 @@
+#ifndef ASSIGNMENTS_EV_PAIRWISE_MATRIX_H_
+#define ASSIGNMENTS_EV_PAIRWISE_MATRIX_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector_batch.h"
+
+// PairwiseMetric is what ComputePairwise puts in cell (i, j) for vectors a[i] and b[j]
+enum class PairwiseMetric {
+  kDotProduct,        // a[i] * b[j], so the Gram matrix when a and b are the same batch
+  kSquaredEuclidean,  // |a[i] - b[j]|^2
+  kEuclidean,         // |a[i] - b[j]|
+};
+
+// PairwiseMatrix is a dense row-major matrix with one row per vector of the first batch
+class PairwiseMatrix {
+ public:
+  PairwiseMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols), values_(static_cast<std::size_t>(rows) * cols, 0.0) {}
+
+  double operator()(int i, int j) const noexcept { return values_[Index(i, j)]; }
+  double& operator()(int i, int j) noexcept { return values_[Index(i, j)]; }
+  int rows() const noexcept { return rows_; }
+  int cols() const noexcept { return cols_; }
+  const double* data() const noexcept { return values_.data(); }
+  double* data() noexcept { return values_.data(); }
+
+ private:
+  std::size_t Index(int i, int j) const noexcept {
+    return static_cast<std::size_t>(i) * cols_ + j;
+  }
+
+  int rows_;
+  int cols_;
+  std::vector<double> values_;
+};
+
+// ComputePairwise fills in metric for every pair of a vector from a and a vector from b.
+// Both batches must have the same dimension, or the EuclideanVector dimension error is thrown.
+//
+// Dot products are accumulated a column of b at a time with the axpy kernel, over tiles of b
+// small enough to stay in cache while a block of rows of a is run against them. Blocks of rows
+// are shared out between num_threads threads (0 for one per hardware thread), and the calling
+// thread works too. Distances come from |a|^2 + |b|^2 - 2 a * b, clamped at 0, so they lose
+// some relative accuracy for vectors much closer to each other than to the origin.
+PairwiseMatrix ComputePairwise(const EuclideanVectorBatch& a,
+                               const EuclideanVectorBatch& b,
+                               PairwiseMetric metric,
+                               std::size_t num_threads = 0);
+
+#endif  // ASSIGNMENTS_EV_PAIRWISE_MATRIX_H_
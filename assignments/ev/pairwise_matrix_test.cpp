@@ -0,0 +1,107 @@
+/*
+
+   Overall approach:
+    - Compare every cell against the EuclideanVector operators on the same pair of vectors
+    - Use a dimension large enough that b is split into several tiles, and batch sizes that
+      leave partial row blocks and partial tiles
+    - Run with one thread, several threads and the default, in both input layouts
+    - Check the dimension error and empty batches
+
+*/
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/euclidean_vector_batch.h"
+#include "assignments/ev/pairwise_matrix.h"
+#include "assignments/ev/test_vectors.h"
+#include "catch.h"
+
+SCENARIO("ComputePairwise matches the EuclideanVector operators") {
+  for (const int dimensions : {3, 2500}) {
+    const auto lhs = WaveVectors(37, dimensions, 0.1);
+    const auto rhs = WaveVectors(21, dimensions, 2.9);
+
+    for (const auto layout : {BatchLayout::kRowMajor, BatchLayout::kColumnMajor}) {
+      const auto a = EuclideanVectorBatch::FromVectors(lhs, layout);
+      const auto b = EuclideanVectorBatch::FromVectors(rhs, layout);
+
+      for (const std::size_t threads : {1, 3, 0}) {
+        GIVEN(std::to_string(dimensions) + " dimensions, layout " +
+              std::to_string(static_cast<int>(layout)) + ", " + std::to_string(threads) +
+              " threads") {
+          WHEN("I compute each metric") {
+            const auto dots = ComputePairwise(a, b, PairwiseMetric::kDotProduct, threads);
+            const auto squared =
+                ComputePairwise(a, b, PairwiseMetric::kSquaredEuclidean, threads);
+            const auto distances = ComputePairwise(a, b, PairwiseMetric::kEuclidean, threads);
+
+            THEN("Every cell matches the pair of vectors it is for") {
+              REQUIRE(dots.rows() == 37);
+              REQUIRE(dots.cols() == 21);
+              for (int i = 0; i < 37; i++) {
+                for (int j = 0; j < 21; j++) {
+                  const auto difference = lhs[i] - rhs[j];
+                  const double expected = difference * difference;
+                  REQUIRE(dots(i, j) == Approx(lhs[i] * rhs[j]).margin(1e-9));
+                  REQUIRE(squared(i, j) == Approx(expected).margin(1e-9));
+                  REQUIRE(distances(i, j) == Approx(std::sqrt(expected)).margin(1e-6));
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("ComputePairwise of a batch with itself") {
+  GIVEN("A batch") {
+    const auto vectors = WaveVectors(50, 17, 1.3);
+    const auto batch = EuclideanVectorBatch::FromVectors(vectors);
+
+    WHEN("I compute its Gram and distance matrices") {
+      const auto gram = ComputePairwise(batch, batch, PairwiseMetric::kDotProduct);
+      const auto distances = ComputePairwise(batch, batch, PairwiseMetric::kSquaredEuclidean);
+
+      THEN("They are symmetric, with the squared norms and zeros on the diagonal") {
+        for (int i = 0; i < 50; i++) {
+          REQUIRE(gram(i, i) == Approx(vectors[i] * vectors[i]));
+          REQUIRE(distances(i, i) == Approx(0).margin(1e-12));
+          REQUIRE(distances(i, i) >= 0);
+          for (int j = 0; j < i; j++) {
+            REQUIRE(gram(i, j) == Approx(gram(j, i)));
+            REQUIRE(distances(i, j) == Approx(distances(j, i)));
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("ComputePairwise errors and edge cases") {
+  GIVEN("Batches of different dimensions") {
+    const EuclideanVectorBatch a(2, 3);
+    const EuclideanVectorBatch b(2, 4);
+    THEN("The dimension error is thrown") {
+      REQUIRE_THROWS_WITH(ComputePairwise(a, b, PairwiseMetric::kDotProduct),
+                          "Dimensions of LHS(3) and RHS(4) do not match");
+    }
+  }
+
+  GIVEN("An empty batch") {
+    const EuclideanVectorBatch a(0, 3);
+    const EuclideanVectorBatch b(4, 3);
+    THEN("The matrix has no cells") {
+      const auto lhs_empty = ComputePairwise(a, b, PairwiseMetric::kEuclidean);
+      const auto rhs_empty = ComputePairwise(b, a, PairwiseMetric::kEuclidean);
+      REQUIRE(lhs_empty.rows() == 0);
+      REQUIRE(lhs_empty.cols() == 4);
+      REQUIRE(rhs_empty.rows() == 4);
+      REQUIRE(rhs_empty.cols() == 0);
+    }
+  }
+}
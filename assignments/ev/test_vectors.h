@@ -0,0 +1,50 @@
+#ifndef ASSIGNMENTS_EV_TEST_VECTORS_H_
+#define ASSIGNMENTS_EV_TEST_VECTORS_H_
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+
+// Vectors the batch, matrix and search tests build their fixtures from. Both generators are
+// deterministic, so a failing case fails the same way every run.
+
+// WaveVectors returns count vectors where dimension j of vector i is
+// sin(phase + 1.7 i + 0.3 j) + offset. Different phases give unrelated looking sets.
+inline std::vector<EuclideanVector>
+WaveVectors(int count, int dimensions, double phase, double offset = 0) {
+  std::vector<EuclideanVector> ret;
+  for (int i = 0; i < count; i++) {
+    EuclideanVector v(dimensions);
+    for (int j = 0; j < dimensions; j++) {
+      v[j] = std::sin(phase + i * 1.7 + j * 0.3) + offset;
+    }
+    ret.push_back(v);
+  }
+  return ret;
+}
+
+// ClusteredVectors scatters count vectors around eight centres drawn from seed, which is
+// closer to real embeddings than evenly spread vectors
+inline std::vector<EuclideanVector> ClusteredVectors(int count, int dimensions, unsigned seed) {
+  std::mt19937 random(seed);
+  std::normal_distribution<double> normal(0, 1);
+  std::vector<EuclideanVector> centres(8, EuclideanVector(dimensions));
+  for (auto& centre : centres) {
+    for (int j = 0; j < dimensions; j++) {
+      centre[j] = 4 * normal(random);
+    }
+  }
+  std::vector<EuclideanVector> ret;
+  for (int i = 0; i < count; i++) {
+    EuclideanVector v = centres[i % centres.size()];
+    for (int j = 0; j < dimensions; j++) {
+      v[j] += normal(random);
+    }
+    ret.push_back(v);
+  }
+  return ret;
+}
+
+#endif  // ASSIGNMENTS_EV_TEST_VECTORS_H_
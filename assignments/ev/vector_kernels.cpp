@@ -0,0 +1,358 @@
+#include "assignments/ev/vector_kernels.h"
+
+#include <cstddef>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define EV_X86_KERNELS 1
+#endif
+
+// Every kernel rounds a product before adding it, as the scalar loops do. GCC would otherwise
+// fuse the two into one FMA inside the AVX-512 functions, whose target implies FMA support.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace {
+
+/* scalar fallback */
+void AddScalar(double* dst, const double* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] += src[i];
+  }
+}
+
+void SubtractScalar(double* dst, const double* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] -= src[i];
+  }
+}
+
+void ScaleScalar(double* dst, double factor, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] *= factor;
+  }
+}
+
+void DivideScalar(double* dst, double divisor, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] /= divisor;
+  }
+}
+
+void AxpyScalar(double* dst, double factor, const double* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] += factor * src[i];
+  }
+}
+
+void MultiplyAddScalar(double* dst, const double* a, const double* b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] += a[i] * b[i];
+  }
+}
+
+double DotScalar(const double* a, const double* b, std::size_t n) {
+  double sum = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+double SumOfSquaresScalar(const double* a, std::size_t n) {
+  return DotScalar(a, a, n);
+}
+
+const VectorKernels kScalar = {"scalar", AddScalar, SubtractScalar, ScaleScalar, DivideScalar,
+                               AxpyScalar, MultiplyAddScalar, DotScalar, SumOfSquaresScalar};
+
+#ifdef EV_X86_KERNELS
+
+/* SSE2, two doubles per register; part of the x86-64 baseline */
+__attribute__((target("sse2"))) void AddSse2(double* dst, const double* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void
+SubtractSse2(double* dst, const double* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_sub_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  SubtractScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(double* dst, double factor, std::size_t n) {
+  const auto f = _mm_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(dst + i), f));
+  }
+  ScaleScalar(dst + i, factor, n - i);
+}
+
+__attribute__((target("sse2"))) void DivideSse2(double* dst, double divisor, std::size_t n) {
+  const auto d = _mm_set1_pd(divisor);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_div_pd(_mm_loadu_pd(dst + i), d));
+  }
+  DivideScalar(dst + i, divisor, n - i);
+}
+
+__attribute__((target("sse2"))) void
+AxpySse2(double* dst, double factor, const double* src, std::size_t n) {
+  const auto f = _mm_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const auto product = _mm_mul_pd(f, _mm_loadu_pd(src + i));
+    _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), product));
+  }
+  AxpyScalar(dst + i, factor, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void
+MultiplyAddSse2(double* dst, const double* a, const double* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const auto product = _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+    _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(dst + i), product));
+  }
+  MultiplyAddScalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("sse2"))) double DotSse2(const double* a, const double* b, std::size_t n) {
+  // two accumulators hide the latency of the adds
+  auto acc0 = _mm_setzero_pd();
+  auto acc1 = _mm_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+  }
+  double lanes[2];
+  _mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+  return lanes[0] + lanes[1] + DotScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("sse2"))) double SumOfSquaresSse2(const double* a, std::size_t n) {
+  return DotSse2(a, a, n);
+}
+
+const VectorKernels kSse2 = {"sse2", AddSse2, SubtractSse2, ScaleSse2, DivideSse2, AxpySse2,
+                             MultiplyAddSse2, DotSse2, SumOfSquaresSse2};
+
+/* AVX2, four doubles per register */
+__attribute__((target("avx2"))) void AddAvx2(double* dst, const double* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i,
+                     _mm256_add_pd(_mm256_loadu_pd(dst + i), _mm256_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void
+SubtractAvx2(double* dst, const double* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i,
+                     _mm256_sub_pd(_mm256_loadu_pd(dst + i), _mm256_loadu_pd(src + i)));
+  }
+  SubtractScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(double* dst, double factor, std::size_t n) {
+  const auto f = _mm256_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), f));
+  }
+  ScaleScalar(dst + i, factor, n - i);
+}
+
+__attribute__((target("avx2"))) void DivideAvx2(double* dst, double divisor, std::size_t n) {
+  const auto d = _mm256_set1_pd(divisor);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_div_pd(_mm256_loadu_pd(dst + i), d));
+  }
+  DivideScalar(dst + i, divisor, n - i);
+}
+
+__attribute__((target("avx2"))) void
+AxpyAvx2(double* dst, double factor, const double* src, std::size_t n) {
+  const auto f = _mm256_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto product = _mm256_mul_pd(f, _mm256_loadu_pd(src + i));
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i), product));
+  }
+  AxpyScalar(dst + i, factor, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void
+MultiplyAddAvx2(double* dst, const double* a, const double* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const auto product = _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i), product));
+  }
+  MultiplyAddScalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) double DotAvx2(const double* a, const double* b, std::size_t n) {
+  auto acc0 = _mm256_setzero_pd();
+  auto acc1 = _mm256_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    acc1 = _mm256_add_pd(acc1,
+                         _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4)));
+  }
+  for (; i + 4 <= n; i += 4) {
+    acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) + DotScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) double SumOfSquaresAvx2(const double* a, std::size_t n) {
+  return DotAvx2(a, a, n);
+}
+
+const VectorKernels kAvx2 = {"avx2", AddAvx2, SubtractAvx2, ScaleAvx2, DivideAvx2, AxpyAvx2,
+                             MultiplyAddAvx2, DotAvx2, SumOfSquaresAvx2};
+
+/* AVX-512, eight doubles per register; masked loads and stores handle the tail */
+__attribute__((target("avx512f"))) void
+AddAvx512(double* dst, const double* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i,
+                     _mm512_add_pd(_mm512_loadu_pd(dst + i), _mm512_loadu_pd(src + i)));
+  }
+  const auto tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(dst + i, tail,
+                        _mm512_add_pd(_mm512_maskz_loadu_pd(tail, dst + i),
+                                      _mm512_maskz_loadu_pd(tail, src + i)));
+}
+
+__attribute__((target("avx512f"))) void
+SubtractAvx512(double* dst, const double* src, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i,
+                     _mm512_sub_pd(_mm512_loadu_pd(dst + i), _mm512_loadu_pd(src + i)));
+  }
+  const auto tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(dst + i, tail,
+                        _mm512_sub_pd(_mm512_maskz_loadu_pd(tail, dst + i),
+                                      _mm512_maskz_loadu_pd(tail, src + i)));
+}
+
+__attribute__((target("avx512f"))) void
+ScaleAvx512(double* dst, double factor, std::size_t n) {
+  const auto f = _mm512_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(dst + i), f));
+  }
+  const auto tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(dst + i, tail, _mm512_mul_pd(_mm512_maskz_loadu_pd(tail, dst + i), f));
+}
+
+__attribute__((target("avx512f"))) void
+DivideAvx512(double* dst, double divisor, std::size_t n) {
+  const auto d = _mm512_set1_pd(divisor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_div_pd(_mm512_loadu_pd(dst + i), d));
+  }
+  DivideScalar(dst + i, divisor, n - i);
+}
+
+__attribute__((target("avx512f"))) void
+AxpyAvx512(double* dst, double factor, const double* src, std::size_t n) {
+  const auto f = _mm512_set1_pd(factor);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const auto product = _mm512_mul_pd(f, _mm512_loadu_pd(src + i));
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i), product));
+  }
+  AxpyScalar(dst + i, factor, src + i, n - i);
+}
+
+__attribute__((target("avx512f"))) void
+MultiplyAddAvx512(double* dst, const double* a, const double* b, std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const auto product = _mm512_mul_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i));
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i), product));
+  }
+  MultiplyAddScalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx512f"))) double
+DotAvx512(const double* a, const double* b, std::size_t n) {
+  auto acc0 = _mm512_setzero_pd();
+  auto acc1 = _mm512_setzero_pd();
+  std::size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+    acc1 = _mm512_add_pd(acc1,
+                         _mm512_mul_pd(_mm512_loadu_pd(a + i + 8), _mm512_loadu_pd(b + i + 8)));
+  }
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+  }
+  const auto tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(_mm512_maskz_loadu_pd(tail, a + i),
+                                           _mm512_maskz_loadu_pd(tail, b + i)));
+  double lanes[8];
+  _mm512_storeu_pd(lanes, _mm512_add_pd(acc0, acc1));
+  return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+         ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+__attribute__((target("avx512f"))) double SumOfSquaresAvx512(const double* a, std::size_t n) {
+  return DotAvx512(a, a, n);
+}
+
+const VectorKernels kAvx512 = {"avx512", AddAvx512, SubtractAvx512, ScaleAvx512, DivideAvx512,
+                               AxpyAvx512, MultiplyAddAvx512, DotAvx512, SumOfSquaresAvx512};
+
+#endif  // EV_X86_KERNELS
+
+}  // namespace
+
+std::vector<const VectorKernels*> AvailableKernels() {
+  std::vector<const VectorKernels*> ret = {&kScalar};
+#ifdef EV_X86_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("sse2")) {
+    ret.push_back(&kSse2);
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    ret.push_back(&kAvx2);
+  }
+  if (__builtin_cpu_supports("avx512f")) {
+    ret.push_back(&kAvx512);
+  }
+#endif
+  return ret;
+}
+
+const VectorKernels& Kernels() noexcept {
+  static const VectorKernels& best = *AvailableKernels().back();
+  return best;
+}
@@ -0,0 +1,31 @@
+#ifndef ASSIGNMENTS_EV_VECTOR_KERNELS_H_
+#define ASSIGNMENTS_EV_VECTOR_KERNELS_H_
+
+#include <cstddef>
+#include <vector>
+
+// VectorKernels is one implementation of the dense loops behind EuclideanVector arithmetic.
+// axpy is dst[i] += factor * src[i] and multiply_add is dst[i] += a[i] * b[i]; both round the
+// product before adding, without fused multiply-add.
+// Elementwise kernels give bit-identical results on every implementation; dot and
+// sum_of_squares add in a different order per instruction set, so they can differ in the
+// last few bits.
+struct VectorKernels {
+  const char* name;
+  void (*add)(double* dst, const double* src, std::size_t n);       // dst[i] += src[i]
+  void (*subtract)(double* dst, const double* src, std::size_t n);  // dst[i] -= src[i]
+  void (*scale)(double* dst, double factor, std::size_t n);         // dst[i] *= factor
+  void (*divide)(double* dst, double divisor, std::size_t n);       // dst[i] /= divisor
+  void (*axpy)(double* dst, double factor, const double* src, std::size_t n);
+  void (*multiply_add)(double* dst, const double* a, const double* b, std::size_t n);
+  double (*dot)(const double* a, const double* b, std::size_t n);
+  double (*sum_of_squares)(const double* a, std::size_t n);
+};
+
+// Kernels returns the widest implementation the running CPU supports, picked on first use
+const VectorKernels& Kernels() noexcept;
+
+// AvailableKernels lists every implementation the running CPU supports, scalar first
+std::vector<const VectorKernels*> AvailableKernels();
+
+#endif  // ASSIGNMENTS_EV_VECTOR_KERNELS_H_
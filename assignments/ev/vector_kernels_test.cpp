@@ -0,0 +1,141 @@
+/*
+
+   Overall approach:
+    - Run every kernel set the CPU supports against the scalar one
+        - Sizes cover empty vectors, every tail length and long vectors
+        - Elementwise kernels must match exactly, reductions to rounding
+    - Check EuclideanVector goes through the kernels with the same results, including single
+      operations assigned to one of their own operands
+
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "assignments/ev/euclidean_vector.h"
+#include "assignments/ev/vector_kernels.h"
+#include "catch.h"
+
+namespace {
+
+std::vector<double> Ramp(std::size_t n, double offset) {
+  std::vector<double> ret(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    ret[i] = offset + static_cast<double>(i % 17) * 0.37 - static_cast<double>(i % 5);
+  }
+  return ret;
+}
+
+}  // namespace
+
+SCENARIO("Every kernel set agrees with the scalar kernels") {
+  GIVEN("The kernel sets this CPU supports") {
+    const auto available = AvailableKernels();
+    const auto& scalar = *available.front();
+    REQUIRE(&Kernels() == available.back());
+
+    std::vector<std::size_t> sizes;
+    for (std::size_t n = 0; n < 40; ++n) {
+      sizes.push_back(n);
+    }
+    sizes.push_back(4096);
+    sizes.push_back(4099);
+
+    for (const auto* kernels : available) {
+      for (const auto n : sizes) {
+        const auto a = Ramp(n, 1.25);
+        const auto b = Ramp(n, -0.5);
+
+        // each section needs its own name, or Catch only ever enters the first of them
+        WHEN(std::string("I run the ") + kernels->name + " kernels on " + std::to_string(n) +
+             " elements") {
+          THEN("The elementwise results are identical") {
+            auto want = a;
+            auto got = a;
+            scalar.add(want.data(), b.data(), n);
+            kernels->add(got.data(), b.data(), n);
+            REQUIRE(got == want);
+            scalar.subtract(want.data(), a.data(), n);
+            kernels->subtract(got.data(), a.data(), n);
+            REQUIRE(got == want);
+            scalar.scale(want.data(), 1.5, n);
+            kernels->scale(got.data(), 1.5, n);
+            REQUIRE(got == want);
+            scalar.divide(want.data(), 3.0, n);
+            kernels->divide(got.data(), 3.0, n);
+            REQUIRE(got == want);
+            scalar.axpy(want.data(), -0.75, b.data(), n);
+            kernels->axpy(got.data(), -0.75, b.data(), n);
+            REQUIRE(got == want);
+            scalar.multiply_add(want.data(), a.data(), b.data(), n);
+            kernels->multiply_add(got.data(), a.data(), b.data(), n);
+            REQUIRE(got == want);
+          }
+
+          THEN("The reductions match up to rounding") {
+            REQUIRE(kernels->dot(a.data(), b.data(), n) ==
+                    Approx(scalar.dot(a.data(), b.data(), n)));
+            REQUIRE(kernels->sum_of_squares(a.data(), n) ==
+                    Approx(scalar.sum_of_squares(a.data(), n)));
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("EuclideanVector arithmetic on long vectors") {
+  GIVEN("Two 1000 dimension vectors") {
+    const auto a = Ramp(1000, 2.0);
+    const auto b = Ramp(1000, 0.75);
+    const EuclideanVector va(a.begin(), a.end());
+    const EuclideanVector vb(b.begin(), b.end());
+
+    WHEN("I add, subtract and scale them") {
+      auto sum = va + vb;
+      auto scaled = (va - vb) * 2.0;
+      THEN("Every dimension is right") {
+        for (unsigned i = 0; i < 1000; ++i) {
+          REQUIRE(sum[i] == a[i] + b[i]);
+          REQUIRE(scaled[i] == (a[i] - b[i]) * 2.0);
+        }
+      }
+    }
+
+    WHEN("I assign single operations on them to vectors they are part of") {
+      EuclideanVector sum = vb;
+      sum = va + sum;
+      EuclideanVector difference = vb;
+      difference = va - difference;
+      EuclideanVector reversed = va;
+      reversed = reversed - vb;
+      EuclideanVector quotient = va;
+      quotient = quotient / 3.0;
+      const EuclideanVector product = va * -1.5;
+      THEN("Every dimension is what the scalar loop gives") {
+        for (unsigned i = 0; i < 1000; ++i) {
+          REQUIRE(sum[i] == a[i] + b[i]);
+          REQUIRE(difference[i] == a[i] - b[i]);
+          REQUIRE(reversed[i] == a[i] - b[i]);
+          REQUIRE(quotient[i] == a[i] / 3.0);
+          REQUIRE(product[i] == a[i] * -1.5);
+        }
+      }
+    }
+
+    WHEN("I take their dot product and norm") {
+      THEN("They match the scalar sums") {
+        double dot = 0;
+        double squares = 0;
+        for (std::size_t i = 0; i < 1000; ++i) {
+          dot += a[i] * b[i];
+          squares += a[i] * a[i];
+        }
+        REQUIRE(va * vb == Approx(dot));
+        REQUIRE(va.GetEuclideanNorm() == Approx(std::sqrt(squares)));
+      }
+    }
+  }
+}
@@ -0,0 +1,45 @@
+#include "assignments/wl/alphabet.h"
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+Alphabet Alphabet::FromLexicon(const std::unordered_set<std::string>& lexicon) {
+  // seen[length][position][byte]
+  std::vector<std::vector<std::array<bool, 256>>> seen;
+  for (const auto& word : lexicon) {
+    if (word.size() >= seen.size()) {
+      seen.resize(word.size() + 1);
+    }
+    auto& positions = seen[word.size()];
+    positions.resize(word.size(), std::array<bool, 256>{});
+    for (std::size_t i = 0; i < word.size(); ++i) {
+      positions[i][static_cast<unsigned char>(word[i])] = true;
+    }
+  }
+
+  Alphabet ret;
+  ret.per_position_.resize(seen.size());
+  for (std::size_t length = 0; length < seen.size(); ++length) {
+    ret.per_position_[length].resize(length);
+    for (std::size_t i = 0; i < seen[length].size(); ++i) {
+      for (std::size_t ch = 0; ch < 256; ++ch) {
+        if (seen[length][i][ch]) {
+          ret.per_position_[length][i] += static_cast<char>(ch);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+const Alphabet& Alphabet::Lowercase() {
+  static const Alphabet lowercase = [] {
+    Alphabet ret;
+    ret.default_letters_ = "abcdefghijklmnopqrstuvwxyz";
+    return ret;
+  }();
+  return lowercase;
+}
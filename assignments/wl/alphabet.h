@@ -0,0 +1,32 @@
+#ifndef ASSIGNMENTS_WL_ALPHABET_H_
+#define ASSIGNMENTS_WL_ALPHABET_H_
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Alphabet says which letters neighbour generation should try at each position of a word.
+// Built from a lexicon it lists, per word length and position, only the bytes some word of
+// that length has there, so candidates that can't be words are never generated.
+class Alphabet {
+ public:
+  static Alphabet FromLexicon(const std::unordered_set<std::string>& lexicon);
+
+  // Lowercase is 'a'..'z' at every position of every length
+  static const Alphabet& Lowercase();
+
+  // Letters returns the bytes to try at position of a word of length, in ascending order
+  const std::string& Letters(std::size_t length, std::size_t position) const noexcept {
+    if (length < per_position_.size() && position < per_position_[length].size()) {
+      return per_position_[length][position];
+    }
+    return default_letters_;
+  }
+
+ private:
+  std::vector<std::vector<std::string>> per_position_;  // [length][position]
+  std::string default_letters_;                         // for lengths not in per_position_
+};
+
+#endif  // ASSIGNMENTS_WL_ALPHABET_H_
@@ -0,0 +1,121 @@
+#include "assignments/wl/batch_pipeline.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "assignments/wl/bounded_queue.h"
+#include "assignments/wl/ladder_writer.h"
+#include "assignments/wl/word_ladder.h"
+
+namespace {
+
+// Job is one parsed pair; a job with done set tells a worker to stop
+struct Job {
+  std::size_t index = 0;
+  std::string start;
+  std::string dest;
+  bool done = false;
+};
+
+// Result is one solved pair; a result with end set says index pairs were read in total
+struct Result {
+  std::size_t index = 0;
+  std::set<std::vector<std::string>> ladders;
+  bool end = false;
+};
+
+std::set<std::vector<std::string>> Solve(const std::unordered_set<std::string>& lexicon,
+                                         const Job& job) {
+  if (job.start.size() != job.dest.size() || job.start == job.dest ||
+      lexicon.find(job.start) == lexicon.end() || lexicon.find(job.dest) == lexicon.end()) {
+    return {};
+  }
+  return WordLadder(lexicon, job.start, job.dest);
+}
+
+}  // namespace
+
+std::size_t RunBatch(const std::unordered_set<std::string>& lexicon,
+                     std::istream& in,
+                     LadderWriter& out,
+                     const BatchOptions& options) {
+  auto num_workers = options.num_workers;
+  if (num_workers == 0) {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  const auto window = std::max<std::size_t>(options.queue_capacity, 1);
+
+  BoundedQueue<Job> jobs(window);
+  BoundedQueue<Result> results(window);
+  // the reader takes a credit for each pair and the writer hands it back once the pair is
+  // written, so the reader sleeps rather than running more than window pairs ahead
+  BoundedQueue<char> credits(window);
+  for (std::size_t i = 0; i < window; ++i) {
+    credits.Push(0);
+  }
+
+  std::thread reader([&]() {
+    Job job;
+    while (in >> job.start >> job.dest) {
+      credits.Pop();
+      jobs.Push(job);
+      ++job.index;
+    }
+    Result end;
+    end.index = job.index;
+    end.end = true;
+    results.Push(std::move(end));
+    for (std::size_t i = 0; i < num_workers; ++i) {
+      Job stop;
+      stop.done = true;
+      jobs.Push(std::move(stop));
+    }
+  });
+
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i < num_workers; ++i) {
+    workers.emplace_back([&]() {
+      for (auto job = jobs.Pop(); !job.done; job = jobs.Pop()) {
+        results.Push(Result{job.index, Solve(lexicon, job)});
+      }
+    });
+  }
+
+  // results arrive in any order; a ring of window slots puts them back in sequence
+  std::vector<std::set<std::vector<std::string>>> pending(window);
+  std::vector<bool> ready(window, false);
+  std::size_t next = 0;
+  auto total = std::numeric_limits<std::size_t>::max();
+  while (next < total) {
+    auto result = results.Pop();
+    if (result.end) {
+      total = result.index;
+      continue;
+    }
+    pending[result.index % window] = std::move(result.ladders);
+    ready[result.index % window] = true;
+    while (ready[next % window]) {
+      out.Write(pending[next % window]);
+      out.Write(std::vector<std::string>{});
+      pending[next % window].clear();
+      ready[next % window] = false;
+      ++next;
+      credits.Push(0);
+    }
+  }
+  out.Flush();
+
+  reader.join();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return next;
+}
@@ -0,0 +1,29 @@
+#ifndef ASSIGNMENTS_WL_BATCH_PIPELINE_H_
+#define ASSIGNMENTS_WL_BATCH_PIPELINE_H_
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <unordered_set>
+
+#include "assignments/wl/ladder_writer.h"
+
+struct BatchOptions {
+  std::size_t num_workers = 0;       // 0 means one per hardware thread
+  std::size_t queue_capacity = 256;  // jobs between stages, and results held back for ordering
+};
+
+// RunBatch solves every "start dest" pair read from in with WordLadder and writes the ladders
+// of each pair to out, followed by an empty ladder (a blank line in text) so consumers can
+// tell pairs apart. Pairs whose words are missing or of different lengths get no ladders.
+//
+// A reader thread parses pairs into a bounded queue, a pool of workers solves them into a
+// second one, and the calling thread writes results back in input order. The reader stops
+// getting ahead once queue_capacity pairs are waiting to be written, so a slow pair holds
+// back input instead of letting finished results pile up. Returns the number of pairs.
+std::size_t RunBatch(const std::unordered_set<std::string>& lexicon,
+                     std::istream& in,
+                     LadderWriter& out,
+                     const BatchOptions& options = BatchOptions{});
+
+#endif  // ASSIGNMENTS_WL_BATCH_PIPELINE_H_
@@ -0,0 +1,162 @@
+/*
+ * Testing Methodology:
+ * - BoundedQueue keeps FIFO order, refuses to overfill and loses nothing under contention
+ * - Threads parked on an empty or full BoundedQueue are woken when it changes
+ * - RunBatch output is exactly the serial WordLadder output, in input order, whatever the
+ *   number of workers and however small the queues
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "assignments/wl/batch_pipeline.h"
+#include "assignments/wl/bounded_queue.h"
+#include "assignments/wl/ladder_writer.h"
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/word_ladder.h"
+#include "catch.h"
+
+namespace {
+
+// RunToString runs a batch into a temporary file and returns what was written
+std::string RunToString(const std::unordered_set<std::string>& lexicon,
+                        const std::string& input,
+                        const BatchOptions& options) {
+  std::FILE* file = std::tmpfile();
+  REQUIRE(file != nullptr);
+  std::istringstream in(input);
+  {
+    LadderWriter writer(fileno(file));
+    RunBatch(lexicon, in, writer, options);
+  }
+  std::string ret;
+  std::rewind(file);
+  char buf[4096];
+  std::size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), file)) > 0) {
+    ret.append(buf, n);
+  }
+  std::fclose(file);
+  return ret;
+}
+
+}  // namespace
+
+SCENARIO("BoundedQueue passes values between threads", "[BoundedQueue]") {
+  GIVEN("A queue with room for four values") {
+    BoundedQueue<int> queue(3);
+    REQUIRE(queue.capacity() == 4);
+
+    THEN("it is first in first out and refuses a fifth value") {
+      for (int i = 0; i < 4; ++i) {
+        REQUIRE(queue.TryPush(i));
+      }
+      int extra = 4;
+      REQUIRE(!queue.TryPush(extra));
+      int value = -1;
+      for (int i = 0; i < 4; ++i) {
+        REQUIRE(queue.TryPop(value));
+        REQUIRE(value == i);
+      }
+      REQUIRE(!queue.TryPop(value));
+    }
+
+    THEN("two producers and two consumers lose and duplicate nothing") {
+      const int per_producer = 20000;
+      std::vector<long> sums(2, 0);
+      std::vector<std::thread> threads;
+      for (int p = 0; p < 2; ++p) {
+        threads.emplace_back([&queue, p]() {
+          for (int i = 1; i <= per_producer; ++i) {
+            queue.Push(p * per_producer + i);
+          }
+        });
+      }
+      for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&queue, &sums, c]() {
+          for (int i = 0; i < per_producer; ++i) {
+            sums[c] += queue.Pop();
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      const long n = 2 * per_producer;
+      REQUIRE(sums[0] + sums[1] == n * (n + 1) / 2);
+    }
+
+    THEN("threads that wait long enough to sleep are woken by the other side") {
+      int popped = 0;
+      std::thread consumer([&queue, &popped]() { popped = queue.Pop(); });
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      queue.Push(7);
+      consumer.join();
+      REQUIRE(popped == 7);
+
+      for (int i = 0; i < 4; ++i) {
+        queue.Push(i);
+      }
+      std::thread producer([&queue]() { queue.Push(4); });
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      for (int i = 0; i < 5; ++i) {
+        REQUIRE(queue.Pop() == i);
+      }
+      producer.join();
+    }
+  }
+}
+
+SCENARIO("RunBatch matches solving pairs one at a time", "[BatchPipeline]") {
+  GIVEN("The proper lexicon and a list of pairs") {
+    const auto lexicon = GetLexicon("data/words.txt");
+    const std::vector<std::pair<std::string, std::string>> pairs = {
+        {"work", "play"}, {"con", "cat"}, {"bean", "make"}, {"cat", "dogs"},
+        {"xyzzy", "plugh"}, {"code", "data"}, {"at", "it"}, {"awake", "sleep"}};
+    std::string input;
+    std::string expected;
+    {
+      std::FILE* file = std::tmpfile();
+      REQUIRE(file != nullptr);
+      {
+        LadderWriter writer(fileno(file));
+        for (const auto& pair : pairs) {
+          input += pair.first + " " + pair.second + "\n";
+          if (pair.first.size() == pair.second.size() && lexicon.count(pair.first) != 0 &&
+              lexicon.count(pair.second) != 0) {
+            writer.Write(WordLadder(lexicon, pair.first, pair.second));
+          }
+          writer.Write(std::vector<std::string>{});
+        }
+        writer.Flush();
+      }
+      std::rewind(file);
+      char buf[4096];
+      std::size_t n;
+      while ((n = std::fread(buf, 1, sizeof(buf), file)) > 0) {
+        expected.append(buf, n);
+      }
+      std::fclose(file);
+    }
+
+    THEN("one worker gives the serial output") {
+      REQUIRE(RunToString(lexicon, input, BatchOptions{1, 256}) == expected);
+    }
+
+    THEN("many workers with tiny queues keep input order") {
+      REQUIRE(RunToString(lexicon, input, BatchOptions{4, 1}) == expected);
+      REQUIRE(RunToString(lexicon, input, BatchOptions{3, 2}) == expected);
+    }
+
+    THEN("empty input produces nothing") {
+      REQUIRE(RunToString(lexicon, "", BatchOptions{2, 4}).empty());
+    }
+  }
+}
@@ -0,0 +1,87 @@
+#include "assignments/wl/bloom_filter.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "assignments/wl/word_hash.h"
+
+namespace {
+
+// bits per block, used to size the filter from the requested bits per key
+const std::size_t kBlockBits = 512;
+
+// BlockIndex maps the high half of a hash onto [0, num_blocks) without a division
+std::size_t BlockIndex(std::uint64_t h, std::size_t num_blocks) {
+  return static_cast<std::size_t>(((h >> 32) * num_blocks) >> 32);
+}
+
+// BitInWord picks the bit key h sets in word i of its block, six hash bits per word
+std::uint64_t BitInWord(std::uint64_t bits, int i) {
+  return std::uint64_t{1} << ((bits >> (6 * i)) & 63);
+}
+
+}  // namespace
+
+BlockedBloomFilter::BlockedBloomFilter(std::size_t num_keys, std::size_t bits_per_key)
+  : blocks_(num_keys == 0 ? 0 : (num_keys * bits_per_key + kBlockBits - 1) / kBlockBits,
+            Block{}) {}
+
+void BlockedBloomFilter::Insert(const std::string& key) noexcept {
+  if (blocks_.empty()) {
+    return;
+  }
+  const auto h = HashWord(key);
+  auto& block = blocks_[BlockIndex(h, blocks_.size())];
+  const auto bits = MixHash(h);
+  for (int i = 0; i < 8; ++i) {
+    block.words[i] |= BitInWord(bits, i);
+  }
+}
+
+bool BlockedBloomFilter::MayContain(const std::string& key) const noexcept {
+  if (blocks_.empty()) {
+    return false;
+  }
+  const auto h = HashWord(key);
+  const auto& block = blocks_[BlockIndex(h, blocks_.size())];
+  const auto bits = MixHash(h);
+  for (int i = 0; i < 8; ++i) {
+    if ((block.words[i] & BitInWord(bits, i)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+LexiconFilter::LexiconFilter(const std::unordered_set<std::string>& lexicon,
+                             std::size_t bits_per_key) {
+  std::vector<std::size_t> counts;
+  for (const auto& word : lexicon) {
+    if (word.size() >= counts.size()) {
+      counts.resize(word.size() + 1);
+    }
+    ++counts[word.size()];
+  }
+  partitions_.reserve(counts.size());
+  for (const auto count : counts) {
+    partitions_.emplace_back(count, bits_per_key);
+  }
+  for (const auto& word : lexicon) {
+    partitions_[word.size()].Insert(word);
+  }
+}
+
+bool LexiconFilter::MayContain(const std::string& word) const noexcept {
+  return word.size() < partitions_.size() && partitions_[word.size()].MayContain(word);
+}
+
+std::size_t LexiconFilter::SizeInBytes() const noexcept {
+  std::size_t total = 0;
+  for (const auto& partition : partitions_) {
+    total += partition.SizeInBytes();
+  }
+  return total;
+}
@@ -0,0 +1,43 @@
+#ifndef ASSIGNMENTS_WL_BLOOM_FILTER_H_
+#define ASSIGNMENTS_WL_BLOOM_FILTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// BlockedBloomFilter keeps all of a key's bits in one 64-byte block, so a query touches a
+// single cache line. Each block is eight 64-bit words and a key sets one bit in each.
+class BlockedBloomFilter {
+ public:
+  BlockedBloomFilter() = default;
+  explicit BlockedBloomFilter(std::size_t num_keys, std::size_t bits_per_key = 12);
+
+  void Insert(const std::string& key) noexcept;
+  bool MayContain(const std::string& key) const noexcept;
+  std::size_t SizeInBytes() const noexcept { return blocks_.size() * sizeof(Block); }
+
+ private:
+  struct alignas(64) Block {
+    std::uint64_t words[8];
+  };
+
+  std::vector<Block> blocks_;
+};
+
+// LexiconFilter holds one BlockedBloomFilter per length partition of a lexicon.
+// MayContain never says no to a word in the lexicon, so a false answer skips the real lookup.
+class LexiconFilter {
+ public:
+  explicit LexiconFilter(const std::unordered_set<std::string>& lexicon,
+                         std::size_t bits_per_key = 12);
+
+  bool MayContain(const std::string& word) const noexcept;
+  std::size_t SizeInBytes() const noexcept;
+
+ private:
+  std::vector<BlockedBloomFilter> partitions_;  // indexed by word length
+};
+
+#endif  // ASSIGNMENTS_WL_BLOOM_FILTER_H_
@@ -0,0 +1,57 @@
+/*
+ * Testing Methodology:
+ * - A Bloom filter must never reject a key it was given
+ * - Its false positive rate on non-words should stay small
+ * - Ladders found through the filter match the unfiltered search
+ */
+#include <string>
+#include <unordered_set>
+
+#include "assignments/wl/bloom_filter.h"
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/search_stats.h"
+#include "assignments/wl/word_ladder.h"
+#include "catch.h"
+
+SCENARIO("LexiconFilter has no false negatives", "[BloomFilter]") {
+  GIVEN("The proper lexicon and its filter") {
+    const auto lexicon = GetLexicon("data/words.txt");
+    const LexiconFilter filter(lexicon);
+
+    THEN("every word may be contained") {
+      std::size_t passed = 0;
+      for (const auto& word : lexicon) {
+        passed += filter.MayContain(word) ? 1 : 0;
+      }
+      REQUIRE(passed == lexicon.size());
+    }
+
+    THEN("most non-words are rejected") {
+      std::size_t probes = 0;
+      std::size_t false_positives = 0;
+      for (const auto& word : lexicon) {
+        auto next = word + "q";
+        if (lexicon.find(next) == lexicon.end()) {
+          ++probes;
+          false_positives += filter.MayContain(next) ? 1 : 0;
+        }
+      }
+      REQUIRE(false_positives * 50 < probes);
+    }
+
+    THEN("words longer than any in the lexicon are rejected") {
+      REQUIRE(!filter.MayContain(std::string(64, 'a')));
+    }
+
+    WHEN("bean -> make is searched through the filter") {
+      SearchStats stats;
+      const auto got = WordLadder(lexicon, filter, "bean", "make", stats);
+
+      THEN("the ladders match and the filter skipped lookups") {
+        REQUIRE(got == WordLadder(lexicon, "bean", "make"));
+        REQUIRE(stats.Totals().filtered > 0);
+        REQUIRE(GetNeighbours(lexicon, filter, "cat") == GetNeighbours(lexicon, "cat"));
+      }
+    }
+  }
+}
@@ -0,0 +1,152 @@
+#ifndef ASSIGNMENTS_WL_BOUNDED_QUEUE_H_
+#define ASSIGNMENTS_WL_BOUNDED_QUEUE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// BoundedQueue is a fixed-capacity multi-producer multi-consumer queue without locks. Every
+// cell carries a sequence number that says whether it is ready to be written or read for the
+// current lap of the ring, so producers and consumers only contend on one atomic each.
+// A full queue makes Push wait, which is how a slow stage pushes back on the one feeding it;
+// a thread that has waited more than a moment sleeps rather than spinning.
+template <typename T>
+class BoundedQueue {
+ public:
+  // capacity is rounded up to a power of two
+  explicit BoundedQueue(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) {
+      size *= 2;
+    }
+    cells_.reset(new Cell[size]);
+    for (std::size_t i = 0; i < size; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask_ = size - 1;
+  }
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  // TryPush moves value into the queue unless it is full
+  bool TryPush(T& value) {
+    auto pos = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& cell = cells_[pos & mask_];
+      const auto lap = Lap(cell.sequence.load(std::memory_order_acquire), pos);
+      if (lap == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lap < 0) {
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // TryPop moves the oldest value out of the queue unless it is empty
+  bool TryPop(T& value) {
+    auto pos = head_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& cell = cells_[pos & mask_];
+      const auto lap = Lap(cell.sequence.load(std::memory_order_acquire), pos + 1);
+      if (lap == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          value = std::move(cell.value);
+          cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (lap < 0) {
+        return false;
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Push and Pop wait for room or a value. They retry briefly in case the other side is about
+  // to catch up, then sleep until it signals, so waiting threads leave their cores to threads
+  // with work to do.
+  void Push(T value) {
+    if (!Spin([&] { return TryPush(value); })) {
+      Park(push_waiters_, not_full_, [&] { return TryPush(value); });
+    }
+    Signal(pop_waiters_, not_empty_);
+  }
+  T Pop() {
+    T value;
+    if (!Spin([&] { return TryPop(value); })) {
+      Park(pop_waiters_, not_empty_, [&] { return TryPop(value); });
+    }
+    Signal(push_waiters_, not_full_);
+    return value;
+  }
+
+  std::size_t capacity() const noexcept { return mask_ + 1; }
+
+ private:
+  // Lap compares a cell's sequence with the one expected, allowing for wraparound: negative
+  // means the cell is a lap behind (full on push, empty on pop), positive that pos is stale
+  static std::ptrdiff_t Lap(std::size_t sequence, std::size_t expected) noexcept {
+    return static_cast<std::ptrdiff_t>(sequence - expected);
+  }
+
+  static constexpr int kSpins = 64;
+
+  template <typename F>
+  static bool Spin(F attempt) {
+    for (int i = 0; i < kSpins; ++i) {
+      if (attempt()) {
+        return true;
+      }
+      std::this_thread::yield();
+    }
+    return false;
+  }
+
+  // Park sleeps on ready until attempt succeeds. Registering as a waiter before the last
+  // attempt, with a fence on each side, means a Signal either sees the waiter or happened
+  // early enough for that attempt to succeed.
+  template <typename F>
+  void Park(std::atomic<int>& waiters, std::condition_variable& ready, F attempt) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    waiters.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ready.wait(lock, attempt);
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  // Signal wakes a thread parked on ready, if there is one; it costs a fence otherwise
+  void Signal(std::atomic<int>& waiters, std::condition_variable& ready) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ready.notify_one();
+    }
+  }
+
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  std::size_t mask_ = 0;
+  alignas(64) std::atomic<std::size_t> head_{0};
+  alignas(64) std::atomic<std::size_t> tail_{0};
+  std::mutex mutex_;  // only taken to sleep and to wake sleepers
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::atomic<int> push_waiters_{0};
+  std::atomic<int> pop_waiters_{0};
+};
+
+#endif  // ASSIGNMENTS_WL_BOUNDED_QUEUE_H_
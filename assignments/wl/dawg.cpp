@@ -0,0 +1,150 @@
+#include "assignments/wl/dawg.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// BuildNode is the mutable node used while the graph is being minimised
+struct BuildNode {
+  bool final = false;
+  std::vector<std::pair<char, std::uint32_t>> edges;
+};
+
+// DawgBuilder implements Daciuk et al.'s incremental construction for sorted input: once a
+// word is added, the nodes it no longer shares with the next word can be merged with an
+// equivalent registered node straight away.
+class DawgBuilder {
+ public:
+  DawgBuilder() : nodes_(1) {}
+
+  void Insert(const std::string& word) {
+    std::size_t common = 0;
+    while (common < word.size() && common < previous_.size() && word[common] == previous_[common]) {
+      ++common;
+    }
+    Minimise(common);
+
+    auto node = unchecked_.empty() ? std::uint32_t{0} : unchecked_.back().child;
+    for (auto i = common; i < word.size(); ++i) {
+      const auto child = static_cast<std::uint32_t>(nodes_.size());
+      nodes_.emplace_back();
+      nodes_[node].edges.emplace_back(word[i], child);
+      unchecked_.push_back({node, child});
+      node = child;
+    }
+    nodes_[node].final = true;
+    previous_ = word;
+  }
+
+  std::vector<BuildNode>& Finish() {
+    Minimise(0);
+    return nodes_;
+  }
+
+ private:
+  struct Unchecked {
+    std::uint32_t parent;
+    std::uint32_t child;
+  };
+
+  // Minimise replaces every unchecked node deeper than depth with its registered equivalent
+  void Minimise(std::size_t depth) {
+    while (unchecked_.size() > depth) {
+      const auto entry = unchecked_.back();
+      unchecked_.pop_back();
+      const auto signature = Signature(nodes_[entry.child]);
+      const auto found = register_.find(signature);
+      if (found != register_.end()) {
+        nodes_[entry.parent].edges.back().second = found->second;
+      } else {
+        register_.emplace(signature, entry.child);
+      }
+    }
+  }
+
+  // Signature encodes a node's finality and outgoing edges; equal signatures mean equal
+  // right languages because children are already minimised
+  static std::string Signature(const BuildNode& node) {
+    std::string sig(1, node.final ? '1' : '0');
+    for (const auto& edge : node.edges) {
+      sig += edge.first;
+      sig.append(reinterpret_cast<const char*>(&edge.second), sizeof(edge.second));
+    }
+    return sig;
+  }
+
+  std::vector<BuildNode> nodes_;
+  std::vector<Unchecked> unchecked_;
+  std::unordered_map<std::string, std::uint32_t> register_;
+  std::string previous_;
+};
+
+}  // namespace
+
+Dawg Dawg::Build(const std::unordered_set<std::string>& lexicon) {
+  std::vector<std::string> words(lexicon.begin(), lexicon.end());
+  std::sort(words.begin(), words.end());
+
+  DawgBuilder builder;
+  for (const auto& word : words) {
+    builder.Insert(word);
+  }
+  const auto& nodes = builder.Finish();
+
+  // renumber the nodes still reachable from the root into the compact arrays
+  const std::uint32_t unvisited = static_cast<std::uint32_t>(-1);
+  std::vector<std::uint32_t> ids(nodes.size(), unvisited);
+  std::vector<std::uint32_t> order = {0};
+  ids[0] = 0;
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    for (const auto& edge : nodes[order[i]].edges) {
+      if (ids[edge.second] == unvisited) {
+        ids[edge.second] = static_cast<std::uint32_t>(order.size());
+        order.push_back(edge.second);
+      }
+    }
+  }
+
+  Dawg ret;
+  ret.size_ = words.size();
+  ret.first_edge_.reserve(order.size() + 1);
+  ret.finals_.reserve(order.size());
+  for (const auto old_id : order) {
+    ret.first_edge_.push_back(static_cast<std::uint32_t>(ret.edges_.size()));
+    ret.finals_.push_back(nodes[old_id].final);
+    for (const auto& edge : nodes[old_id].edges) {
+      ret.edges_.push_back({edge.first, ids[edge.second]});
+    }
+  }
+  ret.first_edge_.push_back(static_cast<std::uint32_t>(ret.edges_.size()));
+  return ret;
+}
+
+bool Dawg::Contains(const std::string& word) const noexcept {
+  if (first_edge_.empty()) {
+    return false;
+  }
+  std::uint32_t node = 0;
+  for (const auto ch : word) {
+    const auto begin = edges_.begin() + first_edge_[node];
+    const auto end = edges_.begin() + first_edge_[node + 1];
+    const auto edge = std::find_if(begin, end, [ch](const Edge& e) { return e.label == ch; });
+    if (edge == end) {
+      return false;
+    }
+    node = edge->target;
+  }
+  return finals_[node];
+}
+
+std::size_t Dawg::SizeInBytes() const noexcept {
+  return first_edge_.size() * sizeof(std::uint32_t) + edges_.size() * sizeof(Edge) +
+         finals_.size() / 8;
+}
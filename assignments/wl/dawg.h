@@ -0,0 +1,75 @@
+#ifndef ASSIGNMENTS_WL_DAWG_H_
+#define ASSIGNMENTS_WL_DAWG_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Dawg is a minimal directed acyclic word graph: a trie whose identical suffix subtrees are
+// shared. Besides membership it can walk the graph allowing exactly one substituted letter,
+// which finds every neighbour of a word without generating and probing candidates.
+class Dawg {
+ public:
+  Dawg() = default;
+
+  static Dawg Build(const std::unordered_set<std::string>& lexicon);
+
+  bool Contains(const std::string& word) const noexcept;
+
+  // ForEachNeighbour calls fn(neighbour) for every word that differs from word in exactly one
+  // position. Neighbours are produced in lexicographic order.
+  template <typename Fn>
+  void ForEachNeighbour(const std::string& word, Fn fn) const {
+    if (first_edge_.empty()) {
+      return;
+    }
+    std::string prefix = word;
+    WalkNeighbours(word, 0, 0, false, prefix, fn);
+  }
+
+  std::size_t size() const noexcept { return size_; }
+  std::size_t NumNodes() const noexcept { return finals_.size(); }
+  std::size_t NumEdges() const noexcept { return edges_.size(); }
+  std::size_t SizeInBytes() const noexcept;
+
+ private:
+  struct Edge {
+    char label;
+    std::uint32_t target;
+  };
+
+  template <typename Fn>
+  void WalkNeighbours(const std::string& word,
+                      std::uint32_t node,
+                      std::size_t depth,
+                      bool substituted,
+                      std::string& prefix,
+                      Fn& fn) const {
+    if (depth == word.size()) {
+      if (substituted && finals_[node]) {
+        fn(static_cast<const std::string&>(prefix));
+      }
+      return;
+    }
+    for (auto e = first_edge_[node]; e < first_edge_[node + 1]; ++e) {
+      const auto& edge = edges_[e];
+      if (edge.label == word[depth]) {
+        WalkNeighbours(word, edge.target, depth + 1, substituted, prefix, fn);
+      } else if (!substituted) {
+        prefix[depth] = edge.label;
+        WalkNeighbours(word, edge.target, depth + 1, true, prefix, fn);
+        prefix[depth] = word[depth];
+      }
+    }
+  }
+
+  // node i owns edges_[first_edge_[i], first_edge_[i + 1]), sorted by label; node 0 is the root
+  std::vector<std::uint32_t> first_edge_;
+  std::vector<Edge> edges_;
+  std::vector<bool> finals_;
+  std::size_t size_ = 0;
+};
+
+#endif  // ASSIGNMENTS_WL_DAWG_H_
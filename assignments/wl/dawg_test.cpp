@@ -0,0 +1,59 @@
+/*
+ * Testing Methodology:
+ * - Membership agrees with the hash set it was built from
+ * - The one-substitution walk finds exactly what GetNeighbours finds
+ * - The minimised graph is much smaller than the trie would be
+ */
+#include <string>
+#include <unordered_set>
+
+#include "assignments/wl/dawg.h"
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/word_ladder.h"
+#include "catch.h"
+
+SCENARIO("Dawg stores a lexicon compactly", "[Dawg]") {
+  GIVEN("A small lexicon sharing suffixes") {
+    const std::unordered_set<std::string> lexicon = {"cat", "cot", "bat", "bot", "cab", "ca"};
+    const auto dawg = Dawg::Build(lexicon);
+
+    THEN("members and non-members are told apart") {
+      REQUIRE(dawg.size() == lexicon.size());
+      for (const auto& word : lexicon) {
+        REQUIRE(dawg.Contains(word));
+      }
+      REQUIRE(!dawg.Contains("c"));
+      REQUIRE(!dawg.Contains("cats"));
+      REQUIRE(!dawg.Contains("dog"));
+    }
+
+    THEN("shared suffixes are merged") {
+      // b-a-t, b-o-t, c-a-t, c-o-t share their "at"/"ot" tails
+      REQUIRE(dawg.NumNodes() < 8);
+    }
+
+    THEN("neighbours differ in exactly one letter") {
+      REQUIRE(GetNeighbours(dawg, "cat") == std::set<std::string>{"bat", "cab", "cot"});
+      REQUIRE(GetNeighbours(dawg, "ca").empty());
+    }
+  }
+
+  GIVEN("The proper lexicon") {
+    const auto lexicon = GetLexicon("data/words.txt");
+    const auto dawg = Dawg::Build(lexicon);
+
+    THEN("every word is found") {
+      std::size_t found = 0;
+      for (const auto& word : lexicon) {
+        found += dawg.Contains(word) ? 1 : 0;
+      }
+      REQUIRE(found == lexicon.size());
+    }
+
+    THEN("neighbours and ladders match the hash set") {
+      REQUIRE(GetNeighbours(dawg, "cat") == GetNeighbours(lexicon, "cat"));
+      REQUIRE(GetNeighbours(dawg, "awake") == GetNeighbours(lexicon, "awake"));
+      REQUIRE(WordLadder(dawg, "bean", "make") == WordLadder(lexicon, "bean", "make"));
+    }
+  }
+}
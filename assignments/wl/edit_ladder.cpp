@@ -0,0 +1,196 @@
+#include "assignments/wl/edit_ladder.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "assignments/wl/word_hash.h"
+
+namespace {
+
+// HashDeleting is HashWord of word with the letter at skip removed, without building it
+std::uint64_t HashDeleting(const std::string& word, std::size_t skip) {
+  std::uint64_t h = 0xcbf29ce484222325ULL;
+  for (std::size_t i = 0; i < word.size(); ++i) {
+    if (i != skip) {
+      h ^= static_cast<unsigned char>(word[i]);
+      h *= 0x100000001b3ULL;
+    }
+  }
+  return MixHash(h);
+}
+
+}  // namespace
+
+DeletionIndex::DeletionIndex(const std::unordered_set<std::string>& lexicon)
+  : words_(lexicon.begin(), lexicon.end()) {
+  std::sort(words_.begin(), words_.end());
+  ids_.reserve(words_.size());
+  for (WordId id = 0; id < words_.size(); ++id) {
+    const auto& word = words_[id];
+    ids_.emplace(word, id);
+    for (std::size_t i = 0; i < word.size(); ++i) {
+      entries_.push_back({HashDeleting(word, i), id, static_cast<std::uint32_t>(i)});
+    }
+  }
+  std::sort(entries_.begin(), entries_.end(), [](const Entry& a, const Entry& b) {
+    return a.key < b.key;
+  });
+}
+
+bool DeletionIndex::Find(const std::string& word, WordId& id) const {
+  const auto it = ids_.find(word);
+  if (it == ids_.end()) {
+    return false;
+  }
+  id = it->second;
+  return true;
+}
+
+std::vector<DeletionIndex::WordId> DeletionIndex::Neighbours(const std::string& word) const {
+  std::vector<WordId> ret;
+  const auto npos = std::string::npos;
+
+  for (std::size_t i = 0; i < word.size(); ++i) {
+    // substitutions share the deletion at the same position
+    ForEachEntry(HashDeleting(word, i), [&](const Entry& entry) {
+      const auto& other = words_[entry.word];
+      if (entry.position == i && other.size() == word.size() && other != word &&
+          SameAfterDeleting(other, i, word, i)) {
+        ret.push_back(entry.word);
+      }
+    });
+
+    // deletions are words in their own right
+    WordId id;
+    if (Find(word.substr(0, i) + word.substr(i + 1), id)) {
+      ret.push_back(id);
+    }
+  }
+
+  // insertions are words that list word itself as one of their deletions
+  ForEachEntry(HashDeleting(word, npos), [&](const Entry& entry) {
+    const auto& other = words_[entry.word];
+    if (other.size() == word.size() + 1 && SameAfterDeleting(other, entry.position, word, npos)) {
+      ret.push_back(entry.word);
+    }
+  });
+
+  std::sort(ret.begin(), ret.end());
+  ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+  return ret;
+}
+
+bool DeletionIndex::SameAfterDeleting(const std::string& a,
+                                      std::size_t a_skip,
+                                      const std::string& b,
+                                      std::size_t b_skip) noexcept {
+  std::size_t i = 0;
+  std::size_t j = 0;
+  while (true) {
+    if (i == a_skip) {
+      ++i;
+    }
+    if (j == b_skip) {
+      ++j;
+    }
+    if (i >= a.size() || j >= b.size()) {
+      return i >= a.size() && j >= b.size();
+    }
+    if (a[i++] != b[j++]) {
+      return false;
+    }
+  }
+}
+
+template <typename Fn>
+void DeletionIndex::ForEachEntry(std::uint64_t key, Fn fn) const {
+  auto it = std::lower_bound(entries_.begin(), entries_.end(), key,
+                             [](const Entry& entry, std::uint64_t k) { return entry.key < k; });
+  for (; it != entries_.end() && it->key == key; ++it) {
+    fn(*it);
+  }
+}
+
+std::set<std::vector<std::string>> EditLadder::Find(const std::string& start,
+                                                    const std::string& dest) const {
+  using WordId = DeletionIndex::WordId;
+  std::set<std::vector<std::string>> output;
+  if (start == dest) {
+    output.insert({start});
+    return output;
+  }
+  WordId target;
+  if (!index_.Find(dest, target)) {
+    return output;
+  }
+
+  // level by level BFS remembering every parent that reaches a word at its shortest depth.
+  // start need not be a word, so it is expanded by string and parents store -1 for it.
+  const WordId kStart = static_cast<WordId>(-1);
+  std::unordered_map<WordId, std::vector<WordId>> parents;
+  std::unordered_set<WordId> visited;
+  std::vector<WordId> frontier;
+  for (const auto id : index_.Neighbours(start)) {
+    parents[id].push_back(kStart);
+    frontier.push_back(id);
+  }
+  WordId start_id;
+  if (index_.Find(start, start_id)) {
+    visited.insert(start_id);
+  }
+  visited.insert(frontier.begin(), frontier.end());
+
+  bool found = parents.count(target) > 0;
+  while (!frontier.empty() && !found) {
+    std::unordered_map<WordId, std::vector<WordId>> next;
+    for (const auto id : frontier) {
+      for (const auto neighbour : index_.Neighbours(index_.Word(id))) {
+        if (visited.find(neighbour) == visited.end()) {
+          next[neighbour].push_back(id);
+          found = found || neighbour == target;
+        }
+      }
+    }
+    frontier.clear();
+    for (auto& entry : next) {
+      visited.insert(entry.first);
+      frontier.push_back(entry.first);
+      parents.insert(std::move(entry));
+    }
+  }
+  if (!found) {
+    return output;
+  }
+
+  // unwind parent links from dest back to start
+  std::vector<WordId> path = {target};
+  std::vector<std::pair<WordId, std::size_t>> stack = {{target, 0}};
+  while (!stack.empty()) {
+    auto& top = stack.back();
+    const auto& ps = parents.at(top.first);
+    if (top.second == ps.size()) {
+      stack.pop_back();
+      path.pop_back();
+      continue;
+    }
+    const auto parent = ps[top.second++];
+    if (parent == kStart) {
+      std::vector<std::string> ladder = {start};
+      for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        ladder.push_back(index_.Word(*it));
+      }
+      output.insert(std::move(ladder));
+      continue;
+    }
+    path.push_back(parent);
+    stack.emplace_back(parent, 0);
+  }
+  return output;
+}
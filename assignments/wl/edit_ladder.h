@@ -0,0 +1,67 @@
+#ifndef ASSIGNMENTS_WL_EDIT_LADDER_H_
+#define ASSIGNMENTS_WL_EDIT_LADDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// DeletionIndex finds the words one insertion, deletion or substitution away from a word
+// without generating every insertion candidate (SymSpell style). Every word is indexed under
+// each of its single-letter deletions: two words of equal length are neighbours when they share
+// a deletion at the same position, and a word is one insertion away from w when w itself is
+// one of its deletions. Keys are hashes of the deleted forms, and hits are checked against the
+// words so a hash collision can never produce a false neighbour.
+class DeletionIndex {
+ public:
+  using WordId = std::uint32_t;
+
+  explicit DeletionIndex(const std::unordered_set<std::string>& lexicon);
+
+  // Neighbours returns the ids of every word at edit distance exactly one from word, sorted
+  std::vector<WordId> Neighbours(const std::string& word) const;
+
+  bool Find(const std::string& word, WordId& id) const;
+  const std::string& Word(WordId id) const noexcept { return words_[id]; }
+  std::size_t size() const noexcept { return words_.size(); }
+
+ private:
+  struct Entry {
+    std::uint64_t key;       // hash of the word with position deleted
+    WordId word;
+    std::uint32_t position;
+  };
+
+  // SameAfterDeleting returns whether a with position a_skip removed equals b with b_skip removed
+  static bool SameAfterDeleting(const std::string& a,
+                                std::size_t a_skip,
+                                const std::string& b,
+                                std::size_t b_skip) noexcept;
+
+  template <typename Fn>
+  void ForEachEntry(std::uint64_t key, Fn fn) const;
+
+  std::vector<std::string> words_;
+  std::unordered_map<std::string, WordId> ids_;
+  std::vector<Entry> entries_;  // sorted by key
+};
+
+// EditLadder finds ladders where each step substitutes, inserts or deletes one letter, so a
+// ladder may move between words of different lengths
+class EditLadder {
+ public:
+  explicit EditLadder(const std::unordered_set<std::string>& lexicon) : index_(lexicon) {}
+
+  // Find returns every shortest ladder from start to dest, like WordLadder
+  std::set<std::vector<std::string>> Find(const std::string& start, const std::string& dest) const;
+
+  const DeletionIndex& index() const noexcept { return index_; }
+
+ private:
+  DeletionIndex index_;
+};
+
+#endif  // ASSIGNMENTS_WL_EDIT_LADDER_H_
@@ -0,0 +1,134 @@
+/*
+ * Testing Methodology:
+ * - DeletionIndex neighbours agree with a brute force edit distance check
+ * - Ladders may change length and are still the shortest
+ *   - On the proper lexicon the length is checked against a BFS that tries every insertion,
+ *     deletion and substitution, so it does not depend on DeletionIndex
+ */
+#include <cstdlib>
+#include <queue>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "assignments/wl/edit_ladder.h"
+#include "assignments/wl/lexicon.h"
+#include "catch.h"
+
+// OneEditApart checks by brute force whether a and b are exactly one edit apart
+bool OneEditApart(const std::string& a, const std::string& b) {
+  if (a == b || std::abs(static_cast<int>(a.size()) - static_cast<int>(b.size())) > 1) {
+    return false;
+  }
+  const auto& shorter = a.size() <= b.size() ? a : b;
+  const auto& longer = a.size() <= b.size() ? b : a;
+  std::size_t i = 0;
+  while (i < shorter.size() && shorter[i] == longer[i]) {
+    ++i;
+  }
+  const auto skip = shorter.size() == longer.size() ? 1 : 0;
+  return shorter.compare(i + skip, std::string::npos, longer, i + 1, std::string::npos) == 0;
+}
+
+// ShortestEditLadder returns the number of words on the shortest ladder from start to dest by
+// a plain BFS over generated candidates, or 0 when there is none
+std::size_t ShortestEditLadder(const std::unordered_set<std::string>& lexicon,
+                               const std::string& start,
+                               const std::string& dest) {
+  std::unordered_map<std::string, std::size_t> length{{start, 1}};
+  std::queue<std::string> frontier;
+  frontier.push(start);
+  while (!frontier.empty()) {
+    const auto word = frontier.front();
+    frontier.pop();
+    if (word == dest) {
+      return length[word];
+    }
+    std::vector<std::string> candidates;
+    for (std::size_t i = 0; i <= word.size(); ++i) {
+      if (i < word.size()) {
+        candidates.push_back(word.substr(0, i) + word.substr(i + 1));
+      }
+      for (char c = 'a'; c <= 'z'; ++c) {
+        candidates.push_back(word.substr(0, i) + c + word.substr(i));
+        if (i < word.size()) {
+          auto substituted = word;
+          substituted[i] = c;
+          candidates.push_back(substituted);
+        }
+      }
+    }
+    for (const auto& next : candidates) {
+      if (lexicon.count(next) != 0 && length.emplace(next, length[word] + 1).second) {
+        frontier.push(next);
+      }
+    }
+  }
+  return 0;
+}
+
+SCENARIO("DeletionIndex finds every word one edit away", "[EditLadder]") {
+  GIVEN("A small lexicon of mixed lengths") {
+    const std::unordered_set<std::string> lexicon = {"cat", "cot", "at",   "cart", "scat",
+                                                     "ca",  "dog", "coat", "a",    "cats"};
+    const DeletionIndex index(lexicon);
+
+    THEN("neighbours match a brute force scan") {
+      for (const auto& word : lexicon) {
+        std::set<std::string> expected;
+        for (const auto& other : lexicon) {
+          if (OneEditApart(word, other)) {
+            expected.insert(other);
+          }
+        }
+        std::set<std::string> got;
+        for (const auto id : index.Neighbours(word)) {
+          got.insert(index.Word(id));
+        }
+        REQUIRE(got == expected);
+      }
+    }
+  }
+}
+
+SCENARIO("EditLadder finds ladders across word lengths", "[EditLadder]") {
+  GIVEN("A small lexicon of mixed lengths") {
+    const EditLadder engine({"cat", "cot", "at", "cart", "scat", "dog", "coat", "cog", "xyzzy"});
+
+    THEN("ladders may insert and delete letters") {
+      REQUIRE(engine.Find("at", "cart") ==
+              std::set<std::vector<std::string>>{{"at", "cat", "cart"}});
+      REQUIRE(engine.Find("scat", "cog") ==
+              std::set<std::vector<std::string>>{{"scat", "cat", "cot", "cog"}});
+      REQUIRE(engine.Find("cart", "coat") ==
+              std::set<std::vector<std::string>>{{"cart", "cat", "coat"}});
+    }
+
+    THEN("unreachable words give nothing") { REQUIRE(engine.Find("cat", "xyzzy").empty()); }
+  }
+
+  GIVEN("The proper lexicon") {
+    const auto lexicon = GetLexicon("data/words.txt");
+    const EditLadder engine(lexicon);
+
+    THEN("every ladder found is a shortest one made of real words one edit apart") {
+      const auto shortest = ShortestEditLadder(lexicon, "bean", "make");
+      REQUIRE(shortest > 0);
+      const auto got = engine.Find("bean", "make");
+      REQUIRE(!got.empty());
+      for (const auto& ladder : got) {
+        REQUIRE(ladder.size() == shortest);
+        REQUIRE(ladder.front() == "bean");
+        REQUIRE(ladder.back() == "make");
+        for (const auto& word : ladder) {
+          REQUIRE(lexicon.count(word) != 0);
+        }
+        for (std::size_t i = 1; i < ladder.size(); ++i) {
+          REQUIRE(OneEditApart(ladder[i - 1], ladder[i]));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,41 @@
+#include "assignments/wl/fixed_length_ladder.h"
+
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "assignments/wl/word_ladder.h"
+
+SpecialisedWordLadder::SpecialisedWordLadder(const std::unordered_set<std::string>& lexicon)
+  : engines_(MakeEngines(lexicon, Indices())) {
+  for (const auto& word : lexicon) {
+    if (word.size() < kMinLength || word.size() > kMaxLength) {
+      other_lengths_.insert(word);
+    }
+  }
+}
+
+std::set<std::vector<std::string>> SpecialisedWordLadder::Find(const std::string& start,
+                                                               const std::string& dest) const {
+  if (start.size() != dest.size()) {
+    return {};
+  }
+  if (start.size() < kMinLength || start.size() > kMaxLength) {
+    return WordLadder(other_lengths_, start, dest);
+  }
+  return Dispatch(start, dest);
+}
+
+// Dispatch walks the engine tuple at compile time until it reaches the one for start's length
+template <std::size_t I>
+std::set<std::vector<std::string>> SpecialisedWordLadder::Dispatch(const std::string& start,
+                                                                   const std::string& dest) const {
+  if constexpr (I + 1 < std::tuple_size<Engines>::value) {
+    if (start.size() != I + kMinLength) {
+      return Dispatch<I + 1>(start, dest);
+    }
+  }
+  return std::get<I>(engines_).Find(start, dest);
+}
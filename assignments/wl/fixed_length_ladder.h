@@ -0,0 +1,193 @@
+#ifndef ASSIGNMENTS_WL_FIXED_LENGTH_LADDER_H_
+#define ASSIGNMENTS_WL_FIXED_LENGTH_LADDER_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "assignments/wl/word_hash.h"
+
+// FixedWord is a word whose length is part of its type
+template <std::size_t N>
+using FixedWord = std::array<char, N>;
+
+// FixedWordHash hashes a FixedWord eight bytes at a time; the loop bound is a constant so
+// short words hash in one or two multiplies
+template <std::size_t N>
+struct FixedWordHash {
+  std::size_t operator()(const FixedWord<N>& word) const noexcept {
+    std::uint64_t h = N;
+    for (std::size_t i = 0; i < N; i += 8) {
+      std::uint64_t chunk = 0;
+      std::memcpy(&chunk, word.data() + i, std::min<std::size_t>(8, N - i));
+      h = MixHash(h ^ chunk);
+    }
+    return static_cast<std::size_t>(h);
+  }
+};
+
+// FixedLengthLadder is the ladder engine for one word length N. Words are std::array<char, N>
+// so hashing, comparison and candidate generation all have compile-time sizes.
+template <std::size_t N>
+class FixedLengthLadder {
+ public:
+  FixedLengthLadder() = default;
+
+  // the engine keeps only the length-N words of lexicon
+  explicit FixedLengthLadder(const std::unordered_set<std::string>& lexicon) {
+    std::array<bool, 256> used = {};
+    for (const auto& word : lexicon) {
+      if (word.size() == N) {
+        const auto fixed = ToFixed(word);
+        words_.insert(fixed);
+        for (const auto ch : fixed) {
+          used[static_cast<unsigned char>(ch)] = true;
+        }
+      }
+    }
+    for (std::size_t ch = 0; ch < used.size(); ++ch) {
+      if (used[ch]) {
+        alphabet_.push_back(static_cast<char>(ch));
+      }
+    }
+  }
+
+  // Find returns every shortest ladder from start to dest, like WordLadder
+  std::set<std::vector<std::string>> Find(const std::string& start, const std::string& dest) const {
+    std::set<std::vector<std::string>> output;
+    if (start.size() != N || dest.size() != N) {
+      return output;
+    }
+    const auto source = ToFixed(start);
+    const auto target = ToFixed(dest);
+    if (source == target) {
+      output.insert({start});
+      return output;
+    }
+
+    // level by level BFS remembering every parent that reaches a word at its shortest depth
+    Parents parents;
+    std::unordered_set<Word, Hash> visited = {source};
+    std::vector<Word> frontier = {source};
+    bool found = false;
+    while (!frontier.empty() && !found) {
+      Parents next;
+      for (const auto& word : frontier) {
+        ForEachNeighbour(word, [&](const Word& neighbour) {
+          if (visited.find(neighbour) == visited.end()) {
+            next[neighbour].push_back(word);
+            found = found || neighbour == target;
+          }
+        });
+      }
+      frontier.clear();
+      for (auto& entry : next) {
+        visited.insert(entry.first);
+        frontier.push_back(entry.first);
+        parents.insert(std::move(entry));
+      }
+    }
+    if (found) {
+      std::vector<Word> path = {target};
+      Unwind(parents, source, path, output);
+    }
+    return output;
+  }
+
+  bool Contains(const std::string& word) const {
+    return word.size() == N && words_.find(ToFixed(word)) != words_.end();
+  }
+  std::size_t size() const noexcept { return words_.size(); }
+
+ private:
+  using Word = FixedWord<N>;
+  using Hash = FixedWordHash<N>;
+  using Parents = std::unordered_map<Word, std::vector<Word>, Hash>;
+
+  static Word ToFixed(const std::string& word) {
+    Word fixed;
+    std::copy_n(word.begin(), N, fixed.begin());
+    return fixed;
+  }
+
+  template <typename Fn>
+  void ForEachNeighbour(const Word& word, Fn fn) const {
+    auto next = word;
+    for (std::size_t i = 0; i < N; ++i) {
+      for (const auto ch : alphabet_) {
+        if (ch != word[i]) {
+          next[i] = ch;
+          if (words_.find(next) != words_.end()) {
+            fn(next);
+          }
+        }
+      }
+      next[i] = word[i];
+    }
+  }
+
+  // Unwind walks parent links from the back of path to source, emitting each ladder found
+  static void Unwind(const Parents& parents,
+                     const Word& source,
+                     std::vector<Word>& path,
+                     std::set<std::vector<std::string>>& output) {
+    if (path.back() == source) {
+      std::vector<std::string> ladder;
+      for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        ladder.emplace_back(it->begin(), it->end());
+      }
+      output.insert(std::move(ladder));
+      return;
+    }
+    for (const auto& parent : parents.at(path.back())) {
+      path.push_back(parent);
+      Unwind(parents, source, path, output);
+      path.pop_back();
+    }
+  }
+
+  std::unordered_set<Word, Hash> words_;
+  std::vector<char> alphabet_;  // every byte used by some length-N word
+};
+
+// SpecialisedWordLadder holds a FixedLengthLadder for every length from 2 to 16 and picks one
+// from the query's length at runtime. Other lengths go through the generic WordLadder.
+class SpecialisedWordLadder {
+ public:
+  static const std::size_t kMinLength = 2;
+  static const std::size_t kMaxLength = 16;
+
+  explicit SpecialisedWordLadder(const std::unordered_set<std::string>& lexicon);
+
+  std::set<std::vector<std::string>> Find(const std::string& start, const std::string& dest) const;
+
+ private:
+  template <std::size_t... Ns>
+  static std::tuple<FixedLengthLadder<Ns + kMinLength>...>
+  MakeEngines(const std::unordered_set<std::string>& lexicon, std::index_sequence<Ns...>) {
+    return std::tuple<FixedLengthLadder<Ns + kMinLength>...>(
+        FixedLengthLadder<Ns + kMinLength>(lexicon)...);
+  }
+
+  using Indices = std::make_index_sequence<kMaxLength - kMinLength + 1>;
+  using Engines = decltype(MakeEngines(std::declval<const std::unordered_set<std::string>&>(),
+                                       Indices()));
+
+  template <std::size_t I = 0>
+  std::set<std::vector<std::string>>
+  Dispatch(const std::string& start, const std::string& dest) const;
+
+  Engines engines_;
+  std::unordered_set<std::string> other_lengths_;
+};
+
+#endif  // ASSIGNMENTS_WL_FIXED_LENGTH_LADDER_H_
@@ -0,0 +1,48 @@
+/*
+ * Testing Methodology:
+ * - The fixed-length engines must agree with the generic WordLadder
+ * - Dispatch covers both specialised and fallback lengths
+ */
+#include <string>
+#include <unordered_set>
+
+#include "assignments/wl/fixed_length_ladder.h"
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/word_ladder.h"
+#include "catch.h"
+
+SCENARIO("FixedLengthLadder matches WordLadder", "[FixedLengthLadder]") {
+  GIVEN("A small lexicon") {
+    const std::unordered_set<std::string> lexicon = {"cat", "cot", "con", "can", "dog", "cats"};
+    const FixedLengthLadder<3> engine(lexicon);
+
+    THEN("only words of its length are kept") {
+      REQUIRE(engine.size() == 5);
+      REQUIRE(engine.Contains("cat"));
+      REQUIRE(!engine.Contains("cats"));
+    }
+
+    THEN("unreachable or mis-sized queries give nothing") {
+      REQUIRE(engine.Find("cat", "dog").empty());
+      REQUIRE(engine.Find("cats", "cots").empty());
+    }
+
+    THEN("a word is a ladder to itself") {
+      REQUIRE(engine.Find("cat", "cat") == std::set<std::vector<std::string>>{{"cat"}});
+    }
+  }
+
+  GIVEN("The proper lexicon and the specialised engines") {
+    const auto lexicon = GetLexicon("data/words.txt");
+    const SpecialisedWordLadder engines(lexicon);
+
+    THEN("results match the generic search") {
+      REQUIRE(engines.Find("con", "cat") == WordLadder(lexicon, "con", "cat"));
+      REQUIRE(engines.Find("bean", "make") == WordLadder(lexicon, "bean", "make"));
+      REQUIRE(engines.Find("work", "play") == WordLadder(lexicon, "work", "play"));
+      REQUIRE(engines.Find("awake", "sleep") == WordLadder(lexicon, "awake", "sleep"));
+    }
+
+    THEN("mismatched lengths give nothing") { REQUIRE(engines.Find("cat", "bean").empty()); }
+  }
+}
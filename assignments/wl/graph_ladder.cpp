@@ -0,0 +1,126 @@
+#include "assignments/wl/graph_ladder.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "assignments/wl/word_graph.h"
+
+namespace {
+
+using Path = std::vector<WordId>;
+
+// Unwind appends to paths every path from source to the back of path, walking backwards
+// through neighbours exactly one BFS level closer to source
+void Unwind(const WordGraph& graph,
+            const std::vector<std::uint32_t>& dist,
+            WordId source,
+            Path& path,
+            std::vector<Path>& paths) {
+  const auto word = path.back();
+  if (word == source) {
+    paths.emplace_back(path.rbegin(), path.rend());
+    return;
+  }
+  for (const auto prev : graph.Adjacent(word)) {
+    if (dist[prev] + 1 == dist[word]) {
+      path.push_back(prev);
+      Unwind(graph, dist, source, path, paths);
+      path.pop_back();
+    }
+  }
+}
+
+// ShortestPaths returns every shortest path from source to target that avoids forbidden
+std::vector<Path> ShortestPaths(const WordGraph& graph,
+                                WordId source,
+                                WordId target,
+                                const WordMask* forbidden) {
+  const auto allowed = [forbidden](WordId id) {
+    return forbidden == nullptr || !forbidden->Test(id);
+  };
+  std::vector<Path> paths;
+  if (!allowed(source) || !allowed(target)) {
+    return paths;
+  }
+
+  std::vector<std::uint32_t> dist(graph.size(), kUnreachable);
+  dist[source] = 0;
+  std::vector<WordId> frontier = {source};
+  std::vector<WordId> next;
+  while (!frontier.empty() && dist[target] == kUnreachable) {
+    next.clear();
+    for (const auto word : frontier) {
+      for (const auto neighbour : graph.Adjacent(word)) {
+        if (dist[neighbour] == kUnreachable && allowed(neighbour)) {
+          dist[neighbour] = dist[word] + 1;
+          next.push_back(neighbour);
+        }
+      }
+    }
+    frontier.swap(next);
+  }
+
+  if (dist[target] != kUnreachable) {
+    Path path = {target};
+    Unwind(graph, dist, source, path, paths);
+  }
+  return paths;
+}
+
+// HasRepeats checks whether a path visits any word twice
+bool HasRepeats(Path path) {
+  std::sort(path.begin(), path.end());
+  return std::adjacent_find(path.begin(), path.end()) != path.end();
+}
+
+}  // namespace
+
+const std::set<std::vector<std::string>> WordLadder(const WordGraph& graph,
+                                                    const std::string& start,
+                                                    const std::string& dest) {
+  return WordLadder(graph, start, dest, LadderConstraints{});
+}
+
+const std::set<std::vector<std::string>> WordLadder(const WordGraph& graph,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    const LadderConstraints& constraints) {
+  std::set<std::vector<std::string>> output;
+  std::vector<WordId> stops = {graph.Find(start)};
+  for (const auto& waypoint : constraints.waypoints) {
+    stops.push_back(graph.Find(waypoint));
+  }
+  stops.push_back(graph.Find(dest));
+  if (std::find(stops.begin(), stops.end(), kNoWord) != stops.end()) {
+    return output;
+  }
+
+  // join shortest paths between consecutive stops, sharing the stop between segments
+  std::vector<Path> ladders = {{stops.front()}};
+  for (std::size_t i = 1; i < stops.size() && !ladders.empty(); ++i) {
+    const auto segments = ShortestPaths(graph, stops[i - 1], stops[i], constraints.forbidden);
+    std::vector<Path> joined;
+    for (const auto& ladder : ladders) {
+      for (const auto& segment : segments) {
+        auto path = ladder;
+        path.insert(path.end(), segment.begin() + 1, segment.end());
+        if (!HasRepeats(path)) {
+          joined.push_back(std::move(path));
+        }
+      }
+    }
+    ladders.swap(joined);
+  }
+
+  for (const auto& ladder : ladders) {
+    std::vector<std::string> words;
+    for (const auto id : ladder) {
+      words.push_back(graph.Word(id));
+    }
+    output.insert(std::move(words));
+  }
+  return output;
+}
@@ -0,0 +1,29 @@
+#ifndef ASSIGNMENTS_WL_GRAPH_LADDER_H_
+#define ASSIGNMENTS_WL_GRAPH_LADDER_H_
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "assignments/wl/word_graph.h"
+
+// LadderConstraints restricts which ladders a WordGraph search may return. The forbidden mask
+// is tested per word as the BFS reaches it, so the lexicon is never copied or filtered.
+struct LadderConstraints {
+  const WordMask* forbidden = nullptr;  // ladders never visit these words
+  std::vector<std::string> waypoints;   // ladders pass through these words, in this order
+};
+
+// WordLadder overloads searching a prebuilt WordGraph. start and dest must both be in the
+// graph. With waypoints, the result is every way of joining shortest ladders between
+// consecutive stops that never repeats a word.
+const std::set<std::vector<std::string>> WordLadder(const WordGraph& graph,
+                                                    const std::string& start,
+                                                    const std::string& dest);
+
+const std::set<std::vector<std::string>> WordLadder(const WordGraph& graph,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    const LadderConstraints& constraints);
+
+#endif  // ASSIGNMENTS_WL_GRAPH_LADDER_H_
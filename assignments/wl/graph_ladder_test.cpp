@@ -0,0 +1,93 @@
+/*
+ * Testing Methodology:
+ * - The graph links exactly the words one letter apart
+ * - Unconstrained graph ladders match WordLadder
+ * - Forbidden words and waypoints shape the result as documented
+ */
+#include <algorithm>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "assignments/wl/graph_ladder.h"
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/word_graph.h"
+#include "assignments/wl/word_ladder.h"
+#include "catch.h"
+
+SCENARIO("WordGraph links words one letter apart", "[WordGraph]") {
+  GIVEN("A small lexicon") {
+    const WordGraph graph({"cat", "cot", "cog", "dog", "a", "b", "bean"});
+
+    THEN("partitions are contiguous id ranges") {
+      const auto threes = graph.Partition(3);
+      REQUIRE(threes.second - threes.first == 4);
+      REQUIRE(graph.Word(threes.first) == "cat");
+      REQUIRE(graph.Partition(2).first == graph.Partition(2).second);
+    }
+
+    THEN("adjacency holds exactly the one-letter neighbours") {
+      std::set<std::string> got;
+      for (const auto id : graph.Adjacent(graph.Find("cot"))) {
+        got.insert(graph.Word(id));
+      }
+      REQUIRE(got == std::set<std::string>{"cat", "cog"});
+      REQUIRE(graph.Adjacent(graph.Find("bean")).size() == 0);
+      REQUIRE(graph.NumEdges() == 4);
+      REQUIRE(graph.Find("cut") == kNoWord);
+    }
+  }
+}
+
+SCENARIO("WordLadder on a WordGraph honours constraints", "[WordGraph][LadderConstraints]") {
+  GIVEN("The proper lexicon and its graph") {
+    const auto lexicon = GetLexicon("data/words.txt");
+    const WordGraph graph(lexicon);
+
+    THEN("unconstrained ladders match the hash set search") {
+      REQUIRE(WordLadder(graph, "bean", "make") == WordLadder(lexicon, "bean", "make"));
+      REQUIRE(WordLadder(graph, "con", "cat") == WordLadder(lexicon, "con", "cat"));
+    }
+
+    WHEN("a word on one of the ladders is forbidden") {
+      const auto mask = graph.MaskOf({"can"});
+      LadderConstraints constraints;
+      constraints.forbidden = &mask;
+      const auto got = WordLadder(graph, "con", "cat", constraints);
+
+      THEN("only the ladder avoiding it is left") {
+        REQUIRE(got == std::set<std::vector<std::string>>{{"con", "cot", "cat"}});
+      }
+    }
+
+    WHEN("both middle words are forbidden") {
+      const auto mask = graph.MaskOf({"can", "cot"});
+      LadderConstraints constraints;
+      constraints.forbidden = &mask;
+      const auto got = WordLadder(graph, "con", "cat", constraints);
+
+      THEN("the ladders get longer and avoid them") {
+        REQUIRE(!got.empty());
+        REQUIRE(got.begin()->size() > 3);
+        for (const auto& ladder : got) {
+          REQUIRE(std::find(ladder.begin(), ladder.end(), "can") == ladder.end());
+          REQUIRE(std::find(ladder.begin(), ladder.end(), "cot") == ladder.end());
+        }
+      }
+    }
+
+    WHEN("a waypoint is required") {
+      LadderConstraints constraints;
+      constraints.waypoints = {"dot"};
+      const auto got = WordLadder(graph, "cat", "dog", constraints);
+
+      THEN("every ladder passes through it") {
+        REQUIRE(!got.empty());
+        for (const auto& ladder : got) {
+          REQUIRE(std::find(ladder.begin(), ladder.end(), "dot") != ladder.end());
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,212 @@
+#include "assignments/wl/graph_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "assignments/wl/word_graph.h"
+
+namespace {
+
+// FarthestFrom returns the word furthest from source and its distance. Ties go to the lowest
+// id so the result does not depend on thread scheduling.
+std::pair<WordId, std::uint32_t> FarthestFrom(const WordGraph& graph, WordId source) {
+  const auto dist = Distances(graph, source);
+  std::pair<WordId, std::uint32_t> farthest = {source, 0};
+  for (WordId id = 0; id < dist.size(); ++id) {
+    if (dist[id] != kUnreachable && dist[id] > farthest.second) {
+      farthest = {id, dist[id]};
+    }
+  }
+  return farthest;
+}
+
+// ParallelFor runs task(0) to task(count - 1) on num_threads threads, the calling thread
+// included, handing out indices in order
+template <typename F>
+void ParallelFor(std::size_t count, std::size_t num_threads, const F& task) {
+  std::atomic<std::size_t> next{0};
+  const auto work = [&]() {
+    for (auto i = next++; i < count; i = next++) {
+      task(i);
+    }
+  };
+  std::vector<std::thread> threads;
+  for (std::size_t i = 1; i < std::min(std::max<std::size_t>(num_threads, 1), count); ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// Survey is what one pass over a partition finds: everything but the BFS sweeps, and the words
+// those sweeps start from
+struct Survey {
+  PartitionStats stats;
+  WordId largest_member = 0;
+  std::vector<WordId> hubs;
+};
+
+Survey SurveyPartition(const WordGraph& graph, std::size_t length, std::size_t num_hubs) {
+  const auto range = graph.Partition(length);
+  Survey survey;
+  auto& stats = survey.stats;
+  stats.length = length;
+  stats.words = range.second - range.first;
+
+  // components by BFS over local ids, remembering one member of the largest
+  std::vector<bool> seen(stats.words, false);
+  std::vector<WordId> queue;
+  survey.largest_member = range.first;
+  std::size_t largest_size = 0;
+  for (auto root = range.first; root < range.second; ++root) {
+    if (seen[root - range.first]) {
+      continue;
+    }
+    queue.assign(1, root);
+    seen[root - range.first] = true;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+      for (const auto neighbour : graph.Adjacent(queue[head])) {
+        if (!seen[neighbour - range.first]) {
+          seen[neighbour - range.first] = true;
+          queue.push_back(neighbour);
+        }
+      }
+    }
+    stats.component_sizes.push_back(queue.size());
+    if (queue.size() > largest_size) {
+      largest_size = queue.size();
+      survey.largest_member = root;
+    }
+  }
+  std::sort(stats.component_sizes.begin(), stats.component_sizes.end(),
+            std::greater<std::size_t>());
+
+  std::vector<std::pair<std::size_t, WordId>> by_degree;
+  for (auto id = range.first; id < range.second; ++id) {
+    const auto degree = graph.Adjacent(id).size();
+    if (degree >= stats.degree_histogram.size()) {
+      stats.degree_histogram.resize(degree + 1, 0);
+    }
+    ++stats.degree_histogram[degree];
+    stats.edges += degree;
+    by_degree.emplace_back(degree, id);
+  }
+  stats.edges /= 2;
+
+  const auto num = std::min(num_hubs, by_degree.size());
+  std::partial_sort(by_degree.begin(), by_degree.begin() + num, by_degree.end(),
+                    [](const std::pair<std::size_t, WordId>& a,
+                       const std::pair<std::size_t, WordId>& b) {
+                      return a.first != b.first ? a.first > b.first : a.second < b.second;
+                    });
+  for (std::size_t i = 0; i < num; ++i) {
+    const auto id = by_degree[i].second;
+    stats.hubs.push_back({graph.Word(id), by_degree[i].first, 0});
+    survey.hubs.push_back(id);
+  }
+  return survey;
+}
+
+// Sweep is one BFS job: a hub's eccentricity, or with hub == kDoubleSweep the two sweeps that
+// bound a partition's diameter
+struct Sweep {
+  std::size_t partition;
+  std::size_t hub;
+};
+
+const std::size_t kDoubleSweep = static_cast<std::size_t>(-1);
+
+}  // namespace
+
+std::vector<PartitionStats>
+AnalyseGraph(const WordGraph& graph, std::size_t num_threads, std::size_t num_hubs) {
+  std::vector<std::size_t> lengths;
+  for (std::size_t length = 1; graph.size() > 0; ++length) {
+    const auto range = graph.Partition(length);
+    if (range.first == graph.size()) {
+      break;
+    }
+    if (range.first != range.second) {
+      lengths.push_back(length);
+    }
+  }
+
+  // hand out the biggest partitions first so one late giant does not leave threads idle
+  std::sort(lengths.begin(), lengths.end(), [&graph](std::size_t a, std::size_t b) {
+    const auto ra = graph.Partition(a);
+    const auto rb = graph.Partition(b);
+    return ra.second - ra.first > rb.second - rb.first;
+  });
+
+  std::vector<Survey> surveys(lengths.size());
+  ParallelFor(lengths.size(), num_threads, [&](std::size_t i) {
+    surveys[i] = SurveyPartition(graph, lengths[i], num_hubs);
+  });
+
+  // every partition's BFS sweeps are separate jobs, so the largest partition, which dominates
+  // the work, has its sweeps spread over all the threads rather than run on one
+  std::vector<Sweep> sweeps;
+  for (std::size_t i = 0; i < surveys.size(); ++i) {
+    sweeps.push_back({i, kDoubleSweep});
+    for (std::size_t hub = 0; hub < surveys[i].hubs.size(); ++hub) {
+      sweeps.push_back({i, hub});
+    }
+  }
+  ParallelFor(sweeps.size(), num_threads, [&](std::size_t i) {
+    auto& survey = surveys[sweeps[i].partition];
+    if (sweeps[i].hub != kDoubleSweep) {
+      const auto hub = sweeps[i].hub;
+      survey.stats.hubs[hub].eccentricity = FarthestFrom(graph, survey.hubs[hub]).second;
+      return;
+    }
+    // double sweep: the word furthest from any word is usually one end of a longest path
+    const auto first = FarthestFrom(graph, survey.largest_member);
+    const auto second = FarthestFrom(graph, first.first);
+    survey.stats.diameter = second.second;
+    survey.stats.diameter_ends = {graph.Word(first.first), graph.Word(second.first)};
+  });
+
+  // the report is in length order
+  std::vector<PartitionStats> report;
+  for (auto& survey : surveys) {
+    report.push_back(std::move(survey.stats));
+  }
+  std::sort(report.begin(), report.end(), [](const PartitionStats& a, const PartitionStats& b) {
+    return a.length < b.length;
+  });
+  return report;
+}
+
+void WriteReport(std::ostream& os, const std::vector<PartitionStats>& report) {
+  for (const auto& stats : report) {
+    os << "length " << stats.length << ": " << stats.words << " words, " << stats.edges
+       << " edges, " << stats.component_sizes.size() << " components\n";
+    os << "  largest components:";
+    for (std::size_t i = 0; i < stats.component_sizes.size() && i < 5; ++i) {
+      os << ' ' << stats.component_sizes[i];
+    }
+    os << "\n  degree histogram:";
+    for (std::size_t degree = 0; degree < stats.degree_histogram.size(); ++degree) {
+      if (stats.degree_histogram[degree] != 0) {
+        os << ' ' << degree << ':' << stats.degree_histogram[degree];
+      }
+    }
+    os << "\n  diameter (double sweep): " << stats.diameter << " from "
+       << stats.diameter_ends.first << " to " << stats.diameter_ends.second << '\n';
+    os << "  hubs:";
+    for (const auto& hub : stats.hubs) {
+      os << ' ' << hub.word << " (degree " << hub.degree << ", eccentricity " << hub.eccentricity
+         << ')';
+    }
+    os << '\n';
+  }
+}
@@ -0,0 +1,45 @@
+#ifndef ASSIGNMENTS_WL_GRAPH_STATS_H_
+#define ASSIGNMENTS_WL_GRAPH_STATS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "assignments/wl/word_graph.h"
+
+// PartitionStats describes the neighbour graph of every word of one length
+struct PartitionStats {
+  std::size_t length = 0;
+  std::size_t words = 0;
+  std::size_t edges = 0;
+  std::vector<std::size_t> component_sizes;   // largest first
+  std::vector<std::size_t> degree_histogram;  // degree_histogram[d] words have d neighbours
+
+  // diameter is a double-sweep lower bound on the largest component's diameter, found
+  // between diameter_ends; it is exact on trees and usually exact on word graphs
+  std::uint32_t diameter = 0;
+  std::pair<std::string, std::string> diameter_ends;
+
+  // hubs are the highest degree words with their degree and eccentricity in their component
+  struct Hub {
+    std::string word;
+    std::size_t degree;
+    std::uint32_t eccentricity;
+  };
+  std::vector<Hub> hubs;
+};
+
+// AnalyseGraph computes PartitionStats for every non-empty length partition of graph, using
+// num_threads threads. The partitions are first surveyed in parallel, largest first; then
+// every BFS sweep of every partition, the double sweep and one per hub, is shared out as a
+// separate job, so one large partition still keeps all the threads busy.
+std::vector<PartitionStats>
+AnalyseGraph(const WordGraph& graph, std::size_t num_threads, std::size_t num_hubs = 5);
+
+// WriteReport prints one block of plain text per partition
+void WriteReport(std::ostream& os, const std::vector<PartitionStats>& report);
+
+#endif  // ASSIGNMENTS_WL_GRAPH_STATS_H_
@@ -0,0 +1,38 @@
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "assignments/wl/graph_stats.h"
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/word_graph.h"
+
+namespace {
+
+// ParseThreads reads a positive thread count, rejecting anything else
+bool ParseThreads(const std::string& arg, std::size_t& num_threads) {
+  if (arg.empty() || arg.size() > 6 ||
+      !std::all_of(arg.begin(), arg.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+    return false;
+  }
+  num_threads = std::stoul(arg);
+  return num_threads > 0;
+}
+
+}  // namespace
+
+// graph_stats prints the structure of every length partition of the lexicon's neighbour graph.
+// An optional argument sets the number of threads, which defaults to the hardware's.
+int main(int argc, char* argv[]) {
+  std::size_t num_threads = std::thread::hardware_concurrency();
+  if (argc > 2 ||
+      (argc == 2 && !ParseThreads(static_cast<std::string>(argv[1]), num_threads))) {
+    std::cerr << "usage: " << argv[0] << " [num_threads]\n";
+    return 1;
+  }
+
+  const WordGraph graph(GetLexicon("data/words.txt"));
+  WriteReport(std::cout, AnalyseGraph(graph, num_threads));
+  return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * Testing Methodology:
+ * - A hand-built lexicon has known components, degrees, diameter and hubs
+ * - The report for the real lexicon does not depend on the number of threads
+ */
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "assignments/wl/graph_stats.h"
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/word_graph.h"
+#include "catch.h"
+
+SCENARIO("AnalyseGraph describes each length partition", "[GraphStats]") {
+  GIVEN("A path of four words, a lone word and a two letter pair") {
+    const WordGraph graph({"cat", "cot", "cog", "dog", "elk", "ab", "ad"});
+    const auto report = AnalyseGraph(graph, 2, 1);
+
+    THEN("there is one entry per length, shortest first") {
+      REQUIRE(report.size() == 2);
+      REQUIRE(report[0].length == 2);
+      REQUIRE(report[1].length == 3);
+    }
+
+    THEN("the three letter partition is measured exactly") {
+      const auto& stats = report[1];
+      REQUIRE(stats.words == 5);
+      REQUIRE(stats.edges == 3);
+      REQUIRE(stats.component_sizes == std::vector<std::size_t>{4, 1});
+      REQUIRE(stats.degree_histogram == std::vector<std::size_t>{1, 2, 2});
+      REQUIRE(stats.diameter == 3);
+      REQUIRE(stats.hubs.size() == 1);
+      REQUIRE(stats.hubs[0].word == "cog");
+      REQUIRE(stats.hubs[0].degree == 2);
+      REQUIRE(stats.hubs[0].eccentricity == 2);
+    }
+
+    THEN("the report mentions every partition") {
+      std::ostringstream os;
+      WriteReport(os, report);
+      REQUIRE(os.str().find("length 2: 2 words, 1 edges, 1 components") != std::string::npos);
+      REQUIRE(os.str().find("diameter (double sweep): 3") != std::string::npos);
+    }
+  }
+
+  GIVEN("The proper lexicon") {
+    const WordGraph graph(GetLexicon("data/words.txt"));
+
+    THEN("one thread and several threads agree") {
+      std::ostringstream serial, parallel;
+      WriteReport(serial, AnalyseGraph(graph, 1));
+      WriteReport(parallel, AnalyseGraph(graph, 4));
+      REQUIRE(serial.str() == parallel.str());
+    }
+  }
+}
@@ -0,0 +1,76 @@
+#include "assignments/wl/ladder_enumerator.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "assignments/wl/word_graph.h"
+
+LadderEnumerator::LadderEnumerator(const WordGraph& graph,
+                                   const std::string& start,
+                                   const std::string& dest,
+                                   std::size_t extra)
+  : graph_(graph), dest_(graph.Find(dest)) {
+  const auto source = graph.Find(start);
+  if (source == kNoWord || dest_ == kNoWord) {
+    return;
+  }
+  to_dest_ = Distances(graph, dest_);
+  shortest_ = to_dest_[source];
+  if (shortest_ == kUnreachable) {
+    return;
+  }
+  bound_ = shortest_ + extra;
+
+  // the forward labels only need to reach as far as the bound
+  const auto from_start = Distances(graph, source, static_cast<std::uint32_t>(bound_));
+  candidates_ = WordMask(graph.size());
+  for (WordId id = 0; id < graph.size(); ++id) {
+    if (from_start[id] != kUnreachable &&
+        static_cast<std::size_t>(from_start[id]) + to_dest_[id] <= bound_) {
+      candidates_.Set(id);
+    }
+  }
+  on_path_ = WordMask(graph.size());
+  path_.push_back(source);
+  cursor_.push_back(0);
+  on_path_.Set(source);
+}
+
+bool LadderEnumerator::OnLadder(WordId word, std::size_t depth) const noexcept {
+  return candidates_.Test(word) && !on_path_.Test(word) && depth + to_dest_[word] <= bound_;
+}
+
+bool LadderEnumerator::Next(std::vector<std::string>& ladder) {
+  while (!path_.empty()) {
+    const auto word = path_.back();
+    const auto neighbours = graph_.Adjacent(word);
+    auto& cursor = cursor_.back();
+
+    // a ladder ends as soon as it reaches dest, going on would only come back to it
+    const bool found = word == dest_;
+    if (found) {
+      ladder.clear();
+      for (const auto id : path_) {
+        ladder.push_back(graph_.Word(id));
+      }
+    }
+    if (found || cursor == neighbours.size()) {
+      on_path_.Reset(word);
+      path_.pop_back();
+      cursor_.pop_back();
+      if (found) {
+        return true;
+      }
+      continue;
+    }
+
+    const auto next = neighbours.begin()[cursor++];
+    if (OnLadder(next, path_.size())) {
+      path_.push_back(next);
+      cursor_.push_back(0);
+      on_path_.Set(next);
+    }
+  }
+  return false;
+}
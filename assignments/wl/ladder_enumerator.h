@@ -0,0 +1,84 @@
+#ifndef ASSIGNMENTS_WL_LADDER_ENUMERATOR_H_
+#define ASSIGNMENTS_WL_LADDER_ENUMERATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "assignments/wl/word_graph.h"
+
+// LadderEnumerator lazily produces every ladder from start to dest that is at most extra steps
+// longer than the shortest one and never repeats a word. Ladders come out in depth-first
+// order, not sorted, and each call to Next does only the work needed to find one more.
+//
+// Distance labels from both ends bound the search: a word can only be on a ladder if its
+// distance from start plus its distance to dest fits the bound, and a partial ladder is only
+// extended to words that can still reach dest in the steps left. With extra == 0 every word
+// left is on a shortest ladder and every branch the DFS takes ends in at least one ladder.
+// With extra steps a branch can still be a dead end, when every route from it to dest within
+// the bound passes through a word already on the ladder.
+class LadderEnumerator {
+ public:
+  LadderEnumerator(const WordGraph& graph,
+                   const std::string& start,
+                   const std::string& dest,
+                   std::size_t extra);
+
+  // Next stores the next ladder in ladder, or returns false once there are no more
+  bool Next(std::vector<std::string>& ladder);
+
+  // ShortestSteps is the number of steps in a shortest ladder, or kUnreachable if there is none
+  std::uint32_t ShortestSteps() const noexcept { return shortest_; }
+
+  class iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = std::vector<std::string>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    reference operator*() const noexcept { return ladder_; }
+    pointer operator->() const noexcept { return &ladder_; }
+    iterator& operator++() {
+      if (!enumerator_->Next(ladder_)) {
+        enumerator_ = nullptr;
+      }
+      return *this;
+    }
+    bool operator==(const iterator& other) const noexcept {
+      return enumerator_ == other.enumerator_;
+    }
+    bool operator!=(const iterator& other) const noexcept { return !(*this == other); }
+
+   private:
+    friend class LadderEnumerator;
+    LadderEnumerator* enumerator_ = nullptr;
+    value_type ladder_;
+  };
+
+  // begin resumes from wherever Next left off, so a range-for consumes the enumerator
+  iterator begin() {
+    iterator it;
+    it.enumerator_ = this;
+    return ++it;
+  }
+  iterator end() noexcept { return iterator{}; }
+
+ private:
+  bool OnLadder(WordId word, std::size_t depth) const noexcept;
+
+  const WordGraph& graph_;
+  WordId dest_ = kNoWord;
+  std::uint32_t shortest_ = kUnreachable;
+  std::size_t bound_ = 0;
+  std::vector<std::uint32_t> to_dest_;  // distance of every word to dest
+  WordMask candidates_;                 // words whose two distance labels fit the bound
+  WordMask on_path_;
+  std::vector<WordId> path_;
+  std::vector<std::size_t> cursor_;  // next adjacency index to try at each depth of path_
+};
+
+#endif  // ASSIGNMENTS_WL_LADDER_ENUMERATOR_H_
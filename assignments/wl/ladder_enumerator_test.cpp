@@ -0,0 +1,113 @@
+/*
+ * Testing Methodology:
+ * - With no extra steps the enumerator yields exactly WordLadder's shortest ladders
+ * - With extra steps it yields the same ladders as a brute-force depth-limited search
+ * - Missing words, unreachable words and partial consumption behave sensibly
+ */
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "assignments/wl/graph_ladder.h"
+#include "assignments/wl/ladder_enumerator.h"
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/word_graph.h"
+#include "catch.h"
+
+namespace {
+
+// BruteForce collects every simple path from the back of path to dest within max_steps
+void BruteForce(const WordGraph& graph,
+                WordId dest,
+                std::size_t max_steps,
+                std::vector<WordId>& path,
+                std::set<std::vector<std::string>>& out) {
+  if (path.back() == dest) {
+    std::vector<std::string> ladder;
+    for (const auto id : path) {
+      ladder.push_back(graph.Word(id));
+    }
+    out.insert(ladder);
+    return;
+  }
+  if (path.size() > max_steps) {
+    return;
+  }
+  for (const auto next : graph.Adjacent(path.back())) {
+    if (std::find(path.begin(), path.end(), next) == path.end()) {
+      path.push_back(next);
+      BruteForce(graph, dest, max_steps, path, out);
+      path.pop_back();
+    }
+  }
+}
+
+std::set<std::vector<std::string>> Collect(LadderEnumerator& enumerator) {
+  std::set<std::vector<std::string>> out;
+  for (const auto& ladder : enumerator) {
+    REQUIRE(out.insert(ladder).second);
+  }
+  return out;
+}
+
+}  // namespace
+
+SCENARIO("LadderEnumerator lists near-shortest ladders", "[LadderEnumerator]") {
+  GIVEN("The proper lexicon and its graph") {
+    const auto lexicon = GetLexicon("data/words.txt");
+    const WordGraph graph(lexicon);
+
+    WHEN("no extra steps are allowed") {
+      LadderEnumerator enumerator(graph, "bean", "make", 0);
+
+      THEN("the shortest ladders come out") {
+        REQUIRE(enumerator.ShortestSteps() == 6);
+        REQUIRE(Collect(enumerator) == WordLadder(graph, "bean", "make"));
+      }
+    }
+
+    for (std::size_t extra = 1; extra <= 2; ++extra) {
+      // each section needs its own name, or Catch only ever enters the first of them
+      WHEN(std::to_string(extra) + " extra steps are allowed") {
+        LadderEnumerator enumerator(graph, "cat", "dog", extra);
+        const auto got = Collect(enumerator);
+
+        std::set<std::vector<std::string>> expected;
+        std::vector<WordId> path = {graph.Find("cat")};
+        BruteForce(graph, graph.Find("dog"), enumerator.ShortestSteps() + extra, path, expected);
+
+        THEN("they match a brute-force search") {
+          REQUIRE(!got.empty());
+          REQUIRE(got == expected);
+        }
+      }
+    }
+
+    WHEN("only some ladders are asked for") {
+      LadderEnumerator enumerator(graph, "work", "play", 3);
+      std::vector<std::string> ladder;
+      std::size_t taken = 0;
+      while (taken < 5 && enumerator.Next(ladder)) {
+        ++taken;
+      }
+
+      THEN("the rest are still there afterwards") {
+        REQUIRE(taken == 5);
+        REQUIRE(ladder.front() == "work");
+        REQUIRE(ladder.back() == "play");
+        REQUIRE(enumerator.begin() != enumerator.end());
+      }
+    }
+
+    THEN("words outside the lexicon or out of reach give nothing") {
+      LadderEnumerator missing(graph, "cat", "xyq", 2);
+      REQUIRE(missing.begin() == missing.end());
+      LadderEnumerator unreachable(graph, "bean", "cat", 2);
+      REQUIRE(unreachable.ShortestSteps() == kUnreachable);
+      REQUIRE(unreachable.begin() == unreachable.end());
+    }
+  }
+}
@@ -0,0 +1,42 @@
+#ifndef ASSIGNMENTS_WL_LADDER_OPTIONS_H_
+#define ASSIGNMENTS_WL_LADDER_OPTIONS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+// CancellationToken lets another thread ask a running search to give up
+class CancellationToken {
+ public:
+  void Cancel() noexcept { cancelled_.store(true, std::memory_order_relaxed); }
+  bool IsCancelled() const noexcept { return cancelled_.load(std::memory_order_relaxed); }
+
+ private:
+  std::atomic<bool> cancelled_{false};
+};
+
+// LadderOptions bounds how much work a single WordLadder query may do. The deadline and token
+// are checked at every level boundary and every few hundred expansions within a level; the
+// node budget is checked before every expansion.
+struct LadderOptions {
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+  std::size_t max_nodes = std::numeric_limits<std::size_t>::max();
+  const CancellationToken* cancel = nullptr;
+};
+
+enum class LadderStatus { kComplete, kTimedOut, kNodeBudgetExceeded, kCancelled };
+
+// LadderResult is what a bounded query returns. When status is not kComplete the search
+// stopped early and ladders holds only the shortest ladders found before it stopped, if any.
+struct LadderResult {
+  LadderStatus status = LadderStatus::kComplete;
+  std::set<std::vector<std::string>> ladders;
+
+  bool complete() const noexcept { return status == LadderStatus::kComplete; }
+};
+
+#endif  // ASSIGNMENTS_WL_LADDER_OPTIONS_H_
@@ -0,0 +1,98 @@
+#include "assignments/wl/ladder_writer.h"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "assignments/wl/lexicon.h"
+
+LadderWriter::LadderWriter(int fd, LadderFormat format, std::size_t capacity)
+  : fd_(fd), format_(format), buffer_(capacity == 0 ? 1 : capacity) {}
+
+LadderWriter::~LadderWriter() noexcept {
+  Drain();
+}
+
+void LadderWriter::Write(const std::vector<std::string>& ladder) {
+  if (format_ == LadderFormat::kText) {
+    for (const auto& word : ladder) {
+      Reserve(word.size() + 1);
+      Append(word.data(), word.size());
+      Append(" ", 1);
+    }
+    Reserve(1);
+    Append("\n", 1);
+    return;
+  }
+
+  if (ladder.size() > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::length_error("Ladder has too many words for the binary format");
+  }
+  for (const auto& word : ladder) {
+    if (word.size() > std::numeric_limits<std::uint16_t>::max()) {
+      throw std::length_error("Word is too long for the binary format");
+    }
+  }
+  const auto count = static_cast<std::uint32_t>(ladder.size());
+  Reserve(sizeof(count));
+  Append(reinterpret_cast<const char*>(&count), sizeof(count));
+  for (const auto& word : ladder) {
+    const auto length = static_cast<std::uint16_t>(word.size());
+    Reserve(sizeof(length) + length);
+    Append(reinterpret_cast<const char*>(&length), sizeof(length));
+    Append(word.data(), length);
+  }
+}
+
+void LadderWriter::Write(const std::set<std::vector<std::string>>& ladders) {
+  for (const auto& ladder : ladders) {
+    Write(ladder);
+  }
+}
+
+void LadderWriter::Flush() {
+  if (!Drain()) {
+    Error("I/O error while writing ladders");
+  }
+}
+
+// Drain hands the buffer to the kernel and returns whether all of it was written
+bool LadderWriter::Drain() noexcept {
+  std::size_t done = 0;
+  while (done < used_) {
+    const auto n = ::write(fd_, buffer_.data() + done, used_ - done);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    done += static_cast<std::size_t>(n);
+  }
+  used_ = 0;
+  return true;
+}
+
+void LadderWriter::Append(const char* data, std::size_t size) {
+  std::memcpy(buffer_.data() + used_, data, size);
+  used_ += size;
+}
+
+// Reserve makes room for size more bytes, flushing the batch or growing the buffer if a
+// single record is bigger than it
+void LadderWriter::Reserve(std::size_t size) {
+  if (used_ + size <= buffer_.size()) {
+    return;
+  }
+  Flush();
+  if (size > buffer_.size()) {
+    buffer_.resize(size);
+  }
+}
@@ -0,0 +1,43 @@
+#ifndef ASSIGNMENTS_WL_LADDER_WRITER_H_
+#define ASSIGNMENTS_WL_LADDER_WRITER_H_
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+// kText matches main's "word word \n" lines. kBinary is for machines: each ladder is a
+// uint32 word count followed by a uint16 length and the bytes of each word, in host byte order.
+// Write throws std::length_error for a ladder or word too long for those fields, before any of
+// the ladder is buffered.
+enum class LadderFormat { kText, kBinary };
+
+// LadderWriter formats ladders into one reusable buffer and hands it to the kernel with a
+// single write() whenever it fills, instead of going through iostreams word by word.
+// Call Flush() when done: the destructor writes out what is left as best it can, but has no
+// way to report a failed write.
+class LadderWriter {
+ public:
+  explicit LadderWriter(int fd,
+                        LadderFormat format = LadderFormat::kText,
+                        std::size_t capacity = 1 << 20);
+  LadderWriter(const LadderWriter&) = delete;
+  LadderWriter& operator=(const LadderWriter&) = delete;
+  ~LadderWriter() noexcept;
+
+  void Write(const std::vector<std::string>& ladder);
+  void Write(const std::set<std::vector<std::string>>& ladders);
+  void Flush();
+
+ private:
+  bool Drain() noexcept;
+  void Append(const char* data, std::size_t size);
+  void Reserve(std::size_t size);
+
+  int fd_;
+  LadderFormat format_;
+  std::vector<char> buffer_;
+  std::size_t used_ = 0;
+};
+
+#endif  // ASSIGNMENTS_WL_LADDER_WRITER_H_
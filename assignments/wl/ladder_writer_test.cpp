@@ -0,0 +1,99 @@
+/*
+ * Testing Methodology:
+ * - Write ladders to a temporary file and read back exactly what was written
+ * - Cover text, binary, and records bigger than the buffer
+ * - Records too long for the binary fields are refused whole, and a writer destroyed without
+ *   Flush still writes what it holds
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "assignments/wl/ladder_writer.h"
+#include "catch.h"
+
+// ReadAll returns everything written to file so far
+std::string ReadAll(std::FILE* file) {
+  std::string ret;
+  std::rewind(file);
+  char buf[256];
+  std::size_t n;
+  while ((n = std::fread(buf, 1, sizeof(buf), file)) > 0) {
+    ret.append(buf, n);
+  }
+  return ret;
+}
+
+SCENARIO("LadderWriter batches ladders into few writes", "[LadderWriter]") {
+  GIVEN("A temporary file and two ladders") {
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != nullptr);
+    const std::set<std::vector<std::string>> ladders = {{"con", "can", "cat"},
+                                                        {"con", "cot", "cat"}};
+
+    WHEN("they are written as text") {
+      {
+        LadderWriter writer(fileno(file));
+        writer.Write(ladders);
+        writer.Flush();
+      }
+      THEN("the output matches the old iostream format") {
+        REQUIRE(ReadAll(file) == "con can cat \ncon cot cat \n");
+      }
+    }
+
+    WHEN("they are written through a buffer smaller than one word") {
+      {
+        LadderWriter writer(fileno(file), LadderFormat::kText, 2);
+        writer.Write(ladders);
+        writer.Flush();
+      }
+      THEN("nothing is lost") { REQUIRE(ReadAll(file) == "con can cat \ncon cot cat \n"); }
+    }
+
+    WHEN("one is written in binary") {
+      {
+        LadderWriter writer(fileno(file), LadderFormat::kBinary);
+        writer.Write(*ladders.begin());
+        writer.Flush();
+      }
+      THEN("it is a word count and length-prefixed words") {
+        const auto out = ReadAll(file);
+        REQUIRE(out.size() == sizeof(std::uint32_t) + 3 * (sizeof(std::uint16_t) + 3));
+        std::uint32_t count;
+        std::uint16_t length;
+        std::memcpy(&count, out.data(), sizeof(count));
+        std::memcpy(&length, out.data() + sizeof(count), sizeof(length));
+        REQUIRE(count == 3);
+        REQUIRE(length == 3);
+        REQUIRE(out.substr(sizeof(count) + sizeof(length), 3) == "con");
+      }
+    }
+
+    WHEN("a word too long for its length field is written in binary") {
+      {
+        LadderWriter writer(fileno(file), LadderFormat::kBinary);
+        writer.Write(std::vector<std::string>{"cat"});
+        REQUIRE_THROWS_AS(writer.Write(std::vector<std::string>{"con", std::string(70000, 'a')}),
+                          std::length_error);
+        writer.Flush();
+      }
+      THEN("none of that ladder is written") {
+        REQUIRE(ReadAll(file).size() == sizeof(std::uint32_t) + sizeof(std::uint16_t) + 3);
+      }
+    }
+
+    WHEN("a writer is destroyed without being flushed") {
+      { LadderWriter(fileno(file)).Write(ladders); }
+      THEN("what it held is still written") {
+        REQUIRE(ReadAll(file) == "con can cat \ncon cot cat \n");
+      }
+    }
+
+    std::fclose(file);
+  }
+}
@@ -0,0 +1,86 @@
+#include "assignments/wl/lexicon_store.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+#include "assignments/wl/perfect_hash_lexicon.h"
+
+namespace {
+
+// ReadLexicon is GetLexicon for a long running process: it throws instead of exiting, so a
+// reload that fails leaves the process, and the snapshot it is serving, as they were
+std::unordered_set<std::string> ReadLexicon(const std::string& filename) {
+  std::ifstream f{filename};
+  if (!f) {
+    throw std::runtime_error("Failed to open file " + filename);
+  }
+  std::unordered_set<std::string> lexicon;
+  std::copy(std::istream_iterator<std::string>(f), {}, std::inserter(lexicon, lexicon.end()));
+  if (f.bad() || !f.eof()) {
+    throw std::runtime_error("Failed to read file " + filename);
+  }
+  return lexicon;
+}
+
+}  // namespace
+
+LexiconSnapshot::LexiconSnapshot(std::uint64_t ver, std::unordered_set<std::string> lexicon)
+  : version(ver), words(std::move(lexicon)), index(PerfectHashLexicon::Build(words)) {}
+
+LexiconStore::LexiconStore(std::unordered_set<std::string> lexicon)
+  : current_(std::make_shared<const LexiconSnapshot>(1, std::move(lexicon))), next_version_(2) {}
+
+std::shared_ptr<const LexiconSnapshot> LexiconStore::Acquire() const noexcept {
+  return std::atomic_load(&current_);
+}
+
+std::uint64_t LexiconStore::Publish(std::unordered_set<std::string> lexicon) {
+  std::unique_lock<std::mutex> lock(writer_);
+  const auto version = next_version_++;
+  lock.unlock();
+
+  // the expensive part runs without any lock held
+  auto next = std::make_shared<const LexiconSnapshot>(version, std::move(lexicon));
+
+  lock.lock();
+  if (Acquire()->version > version) {
+    // a later reload finished first, it stays current and ours is never seen
+    return Acquire()->version;
+  }
+  retired_.push_back(std::atomic_exchange(&current_, std::move(next)));
+  lock.unlock();
+
+  Reclaim();
+  return version;
+}
+
+std::future<std::uint64_t> LexiconStore::ReloadAsync(const std::string& filename) {
+  return std::async(std::launch::async,
+                    [this, filename] { return Publish(ReadLexicon(filename)); });
+}
+
+std::size_t LexiconStore::Reclaim() {
+  std::vector<std::shared_ptr<const LexiconSnapshot>> drained;
+  std::unique_lock<std::mutex> lock(writer_);
+  // use_count of 1 means only the retired list still refers to the snapshot
+  const auto still_read = std::partition(
+      retired_.begin(), retired_.end(),
+      [](const std::shared_ptr<const LexiconSnapshot>& s) { return s.use_count() > 1; });
+  drained.assign(std::make_move_iterator(still_read), std::make_move_iterator(retired_.end()));
+  retired_.erase(still_read, retired_.end());
+  const auto remaining = retired_.size();
+  lock.unlock();
+
+  // drained snapshots are destroyed here, on the writer's thread and outside the lock
+  drained.clear();
+  return remaining;
+}
@@ -0,0 +1,57 @@
+#ifndef ASSIGNMENTS_WL_LEXICON_STORE_H_
+#define ASSIGNMENTS_WL_LEXICON_STORE_H_
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "assignments/wl/perfect_hash_lexicon.h"
+
+// LexiconSnapshot is one immutable version of the lexicon and the index derived from it
+struct LexiconSnapshot {
+  LexiconSnapshot(std::uint64_t version, std::unordered_set<std::string> words);
+
+  const std::uint64_t version;
+  const std::unordered_set<std::string> words;
+  const PerfectHashLexicon index;
+};
+
+// LexiconStore publishes lexicon snapshots RCU style. Queries Acquire the current snapshot and
+// keep using it until they finish, however many reloads happen meanwhile. A reload builds the
+// next snapshot off to the side and swaps it in with one atomic pointer store. Snapshots that
+// have been replaced are retired, and freed by the writer once their last reader lets go, so
+// query threads never pay for tearing down a lexicon.
+class LexiconStore {
+ public:
+  explicit LexiconStore(std::unordered_set<std::string> lexicon);
+  LexiconStore(const LexiconStore&) = delete;
+  LexiconStore& operator=(const LexiconStore&) = delete;
+
+  std::shared_ptr<const LexiconSnapshot> Acquire() const noexcept;
+  std::uint64_t version() const noexcept { return Acquire()->version; }
+
+  // Publish builds a snapshot of lexicon on the calling thread and makes it current, unless a
+  // reload that started later has already been published
+  std::uint64_t Publish(std::unordered_set<std::string> lexicon);
+
+  // ReloadAsync reads filename like GetLexicon and publishes it from a background thread.
+  // The future yields the version current once it finishes, and must be waited on before
+  // the store is destroyed. If the file cannot be read the future throws std::runtime_error
+  // and the current snapshot stays current.
+  std::future<std::uint64_t> ReloadAsync(const std::string& filename);
+
+  // Reclaim frees retired snapshots no reader holds any more, returning how many are left
+  std::size_t Reclaim();
+
+ private:
+  std::shared_ptr<const LexiconSnapshot> current_;
+  std::mutex writer_;  // serialises publishers; readers never take it
+  std::vector<std::shared_ptr<const LexiconSnapshot>> retired_;
+  std::uint64_t next_version_ = 1;
+};
+
+#endif  // ASSIGNMENTS_WL_LEXICON_STORE_H_
@@ -0,0 +1,122 @@
+/*
+ * Testing Methodology:
+ * - Snapshots stay valid for their holders across reloads
+ * - Retired snapshots are only freed once nobody reads them
+ * - Queries keep running while a reload happens in the background
+ * - A reload of a file that cannot be read fails through its future, not by exiting
+ */
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "assignments/wl/lexicon_store.h"
+#include "assignments/wl/word_ladder.h"
+#include "catch.h"
+
+namespace {
+
+// Readers stops and joins the query threads however a section ends, so a failed REQUIRE
+// does not destroy threads that are still running
+struct Readers {
+  explicit Readers(std::atomic<bool>& s) : stop(s) {}
+  ~Readers() {
+    stop = true;
+    for (auto& thread : threads) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+  }
+
+  std::atomic<bool>& stop;
+  std::vector<std::thread> threads;
+};
+
+}  // namespace
+
+SCENARIO("LexiconStore swaps snapshots without disturbing readers", "[LexiconStore]") {
+  GIVEN("A store holding a small lexicon") {
+    LexiconStore store({"cat", "cot", "dog"});
+    REQUIRE(store.version() == 1);
+
+    WHEN("a reader holds the first snapshot while a new lexicon is published") {
+      auto old_snapshot = store.Acquire();
+      const auto version = store.Publish({"cat", "cot", "cog", "dog"});
+
+      THEN("the reader still sees the old words and new readers see the new ones") {
+        REQUIRE(version == 2);
+        REQUIRE(old_snapshot->words.size() == 3);
+        REQUIRE(!old_snapshot->index.Contains("cog"));
+        REQUIRE(store.Acquire()->index.Contains("cog"));
+      }
+
+      THEN("the old snapshot is only reclaimed after the reader lets go") {
+        REQUIRE(store.Reclaim() == 1);
+        const std::weak_ptr<const LexiconSnapshot> watch = old_snapshot;
+        old_snapshot.reset();
+        REQUIRE(store.Reclaim() == 0);
+        REQUIRE(watch.expired());
+      }
+    }
+  }
+
+  GIVEN("Query threads running against the store") {
+    LexiconStore store({"con", "cot", "cat", "can"});
+    std::atomic<bool> stop{false};
+    std::atomic<int> answered{0};
+    Readers readers(stop);
+    for (int i = 0; i < 4; ++i) {
+      readers.threads.emplace_back([&store, &stop, &answered] {
+        while (!stop) {
+          const auto snapshot = store.Acquire();
+          if (WordLadder(snapshot->index, "con", "cat").size() == 2) {
+            ++answered;
+          }
+        }
+      });
+    }
+
+    WHEN("the real lexicon is loaded in the background") {
+      const auto version = store.ReloadAsync("data/words.txt").get();
+      stop = true;
+      for (auto& reader : readers.threads) {
+        reader.join();
+      }
+
+      THEN("every query succeeded and the new lexicon is current") {
+        REQUIRE(answered > 0);
+        REQUIRE(version == 2);
+        REQUIRE(store.Acquire()->words.size() > 100000);
+        REQUIRE(store.Reclaim() == 0);
+      }
+    }
+
+    WHEN("a file that does not exist is loaded in the background") {
+      bool threw = false;
+      try {
+        store.ReloadAsync("data/no_such_words.txt").get();
+      } catch (const std::runtime_error&) {
+        threw = true;
+      }
+      // let the readers answer at least one more query after the failed reload
+      const auto before = answered.load();
+      while (answered == before) {
+        std::this_thread::yield();
+      }
+      stop = true;
+      for (auto& reader : readers.threads) {
+        reader.join();
+      }
+
+      THEN("the future throws and the old lexicon is still served") {
+        REQUIRE(threw);
+        REQUIRE(store.Acquire()->version == 1);
+        REQUIRE(store.Acquire()->words.size() == 4);
+      }
+    }
+  }
+}
@@ -1,15 +1,34 @@
+#include <unistd.h>
+
 #include <algorithm>
 #include <iostream>
 #include <set>
 #include <string>
 #include <unordered_set>
 
+#include "assignments/wl/alphabet.h"
+#include "assignments/wl/batch_pipeline.h"
+#include "assignments/wl/edit_ladder.h"
+#include "assignments/wl/ladder_writer.h"
 #include "assignments/wl/lexicon.h"
 #include "assignments/wl/word_ladder.h"
 
-int main() {
+int main(int argc, char* argv[]) {
   std::string start, dest;
 
+  // --edit allows steps that insert or delete a letter as well as substitute one
+  const bool edit_mode = argc > 1 && static_cast<std::string>(argv[1]) == "--edit";
+
+  // --batch reads "start dest" pairs from stdin until EOF and prints each pair's ladders
+  // followed by a blank line
+  if (argc > 1 && static_cast<std::string>(argv[1]) == "--batch") {
+    const auto full_lexicon = GetLexicon("data/words.txt");
+    LadderWriter writer(STDOUT_FILENO);
+    RunBatch(full_lexicon, std::cin, writer);
+    writer.Flush();
+    return 0;
+  }
+
   std::cout << "Enter start word (RETURN to quit): ";
   std::getline(std::cin, start);
   if (start.size() <= 1) {
@@ -28,6 +47,21 @@ int main() {
   auto lexicon = GetLexicon("data/words.txt");
    */
 
+  if (edit_mode) {
+    auto full_lexicon = GetLexicon("data/words.txt");
+    if (full_lexicon.find(start) == full_lexicon.end() ||
+        full_lexicon.find(dest) == full_lexicon.end()) {
+      std::cerr << "words are not in lexicon\n";
+      return 1;
+    }
+    std::cout << "Found ladder: " << std::flush;
+    const EditLadder engine(full_lexicon);
+    LadderWriter writer(STDOUT_FILENO);
+    writer.Write(engine.Find(start, dest));
+    writer.Flush();
+    return 0;
+  }
+
   // cut down lexicon to strings of correct size and put in unordered_set
   const std::string::size_type strlen = start.size();
   auto full_lexicon = GetLexicon("data/words.txt");
@@ -42,14 +76,12 @@ int main() {
     return 1;
   }
 
-  std::cout << "Found ladder: ";
-  auto ladders = WordLadder(lexicon, start, dest);
-  for (const auto& ladder : ladders) {
-    for (const auto& word : ladder) {
-      std::cout << word + " ";
-    }
-    std::cout << "\n";
-  }
+  std::cout << "Found ladder: " << std::flush;
+  const auto alphabet = Alphabet::FromLexicon(lexicon);
+  auto ladders = WordLadder(lexicon, alphabet, start, dest);
+  LadderWriter writer(STDOUT_FILENO);
+  writer.Write(ladders);
+  writer.Flush();
   /*
    */
 
@@ -0,0 +1,69 @@
+#include "assignments/wl/packed_lexicon.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+bool PackWord(const std::string& word, std::uint64_t& key) noexcept {
+  if (word.empty() || word.size() > kMaxPackedLength) {
+    return false;
+  }
+  std::uint64_t packed = 0;
+  for (std::size_t i = 0; i < word.size(); ++i) {
+    if (word[i] < 'a' || word[i] > 'z') {
+      return false;
+    }
+    packed |= static_cast<std::uint64_t>(word[i] - 'a' + 1) << (5 * i);
+  }
+  key = packed;
+  return true;
+}
+
+std::string UnpackWord(std::uint64_t key) {
+  std::string word;
+  for (; key != 0; key >>= 5) {
+    word += static_cast<char>('a' + (key & kLetterMask) - 1);
+  }
+  return word;
+}
+
+PackedLexicon::PackedLexicon(const std::unordered_set<std::string>& lexicon) {
+  // keep the table at most half full so probe sequences stay short
+  std::size_t capacity = 16;
+  while (capacity < 2 * lexicon.size()) {
+    capacity *= 2;
+  }
+  slots_.assign(capacity, 0);
+  mask_ = capacity - 1;
+
+  for (const auto& word : lexicon) {
+    std::uint64_t key;
+    if (PackWord(word, key)) {
+      Insert(key);
+    } else {
+      unpacked_.insert(word);
+    }
+  }
+}
+
+bool PackedLexicon::Contains(const std::string& word) const {
+  std::uint64_t key;
+  if (PackWord(word, key)) {
+    return Contains(key);
+  }
+  return unpacked_.find(word) != unpacked_.end();
+}
+
+void PackedLexicon::Insert(std::uint64_t key) {
+  for (auto slot = MixHash(key) & mask_;; slot = (slot + 1) & mask_) {
+    if (slots_[slot] == key) {
+      return;
+    }
+    if (slots_[slot] == 0) {
+      slots_[slot] = key;
+      ++packed_;
+      return;
+    }
+  }
+}
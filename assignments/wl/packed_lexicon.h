@@ -0,0 +1,74 @@
+#ifndef ASSIGNMENTS_WL_PACKED_LEXICON_H_
+#define ASSIGNMENTS_WL_PACKED_LEXICON_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "assignments/wl/word_hash.h"
+
+// A packed key stores up to kMaxPackedLength lowercase letters at 5 bits each, letter i in
+// bits [5i, 5i + 5) as 'a' = 1 ... 'z' = 26. Code 0 marks the end of the word, so words of
+// different lengths never share a key.
+const std::size_t kMaxPackedLength = 12;
+const std::uint64_t kLetterMask = 0x1f;
+
+// PackWord stores the key for word in key and returns true, or returns false if word is
+// empty, too long, or has anything but 'a'..'z'
+bool PackWord(const std::string& word, std::uint64_t& key) noexcept;
+std::string UnpackWord(std::uint64_t key);
+
+// PackedLexicon keeps every packable word as a uint64_t in an open addressing hash set, so
+// membership is a multiply, a mask and usually one load. Words that don't pack are kept in an
+// ordinary hash set on the side, so the lexicon as a whole loses nothing.
+class PackedLexicon {
+ public:
+  explicit PackedLexicon(const std::unordered_set<std::string>& lexicon);
+
+  bool Contains(std::uint64_t key) const noexcept {
+    for (auto slot = MixHash(key) & mask_;; slot = (slot + 1) & mask_) {
+      if (slots_[slot] == key) {
+        return true;
+      }
+      if (slots_[slot] == 0) {
+        return false;
+      }
+    }
+  }
+  bool Contains(const std::string& word) const;
+
+  // ForEachNeighbour calls fn(neighbour_key) for every packed word one letter away from key.
+  // Candidates are made by swapping a 5-bit field, so nothing is allocated.
+  template <typename Fn>
+  void ForEachNeighbour(std::uint64_t key, Fn fn) const {
+    for (std::size_t shift = 0; shift < 5 * kMaxPackedLength; shift += 5) {
+      const auto current = (key >> shift) & kLetterMask;
+      if (current == 0) {
+        break;
+      }
+      const auto cleared = key & ~(kLetterMask << shift);
+      for (std::uint64_t letter = 1; letter <= 26; ++letter) {
+        const auto candidate = cleared | (letter << shift);
+        if (letter != current && Contains(candidate)) {
+          fn(candidate);
+        }
+      }
+    }
+  }
+
+  std::size_t size() const noexcept { return packed_ + unpacked_.size(); }
+  std::size_t NumUnpacked() const noexcept { return unpacked_.size(); }
+  const std::unordered_set<std::string>& Unpacked() const noexcept { return unpacked_; }
+
+ private:
+  void Insert(std::uint64_t key);
+
+  std::vector<std::uint64_t> slots_;  // 0 marks an empty slot
+  std::uint64_t mask_ = 0;
+  std::size_t packed_ = 0;
+  std::unordered_set<std::string> unpacked_;
+};
+
+#endif  // ASSIGNMENTS_WL_PACKED_LEXICON_H_
@@ -0,0 +1,79 @@
+/*
+ * Testing Methodology:
+ * - Packing round-trips and rejects what it can't represent
+ * - Membership and neighbours agree with the hash set, unpackable words included
+ */
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/packed_lexicon.h"
+#include "assignments/wl/word_ladder.h"
+#include "catch.h"
+
+SCENARIO("Words pack into 64-bit keys", "[PackedLexicon]") {
+  GIVEN("Some words") {
+    std::uint64_t key = 0;
+
+    THEN("lowercase words of up to 12 letters round-trip") {
+      REQUIRE(PackWord("a", key));
+      REQUIRE(UnpackWord(key) == "a");
+      REQUIRE(PackWord("zzzzzzzzzzzz", key));
+      REQUIRE(UnpackWord(key) == "zzzzzzzzzzzz");
+    }
+
+    THEN("prefixes get different keys") {
+      std::uint64_t longer = 0;
+      REQUIRE(PackWord("cat", key));
+      REQUIRE(PackWord("cats", longer));
+      REQUIRE(key != longer);
+    }
+
+    THEN("everything else is refused") {
+      REQUIRE(!PackWord("", key));
+      REQUIRE(!PackWord("abcdefghijklm", key));
+      REQUIRE(!PackWord("Cat", key));
+      REQUIRE(!PackWord("c4t", key));
+    }
+  }
+}
+
+SCENARIO("PackedLexicon matches the hash set", "[PackedLexicon]") {
+  GIVEN("A lexicon with words that do and don't pack") {
+    const std::unordered_set<std::string> lexicon = {"cat", "cot", "cut", "Cat", "abcdefghijklmn"};
+    const PackedLexicon packed(lexicon);
+
+    THEN("every word is a member") {
+      REQUIRE(packed.size() == lexicon.size());
+      REQUIRE(packed.NumUnpacked() == 2);
+      for (const auto& word : lexicon) {
+        REQUIRE(packed.Contains(word));
+      }
+      REQUIRE(!packed.Contains("cab"));
+    }
+
+    THEN("neighbours come from swapping letters") {
+      REQUIRE(GetNeighbours(packed, "cat") == std::set<std::string>{"cot", "cut"});
+    }
+  }
+
+  GIVEN("The proper lexicon") {
+    const auto lexicon = GetLexicon("data/words.txt");
+    const PackedLexicon packed(lexicon);
+
+    THEN("most words pack and all are found") {
+      REQUIRE(packed.NumUnpacked() * 10 < lexicon.size());
+      std::size_t found = 0;
+      for (const auto& word : lexicon) {
+        found += packed.Contains(word) ? 1 : 0;
+      }
+      REQUIRE(found == lexicon.size());
+    }
+
+    THEN("ladders match the hash set") {
+      REQUIRE(GetNeighbours(packed, "awake") == GetNeighbours(lexicon, "awake"));
+      REQUIRE(WordLadder(packed, "bean", "make") == WordLadder(lexicon, "bean", "make"));
+    }
+  }
+}
@@ -0,0 +1,262 @@
+#include "assignments/wl/perfect_hash_lexicon.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <new>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/word_hash.h"
+
+namespace {
+
+const char kMagic[4] = {'W', 'L', 'P', 'H'};
+const std::uint32_t kVersion = 1;
+
+// average number of words per CHD bucket
+const std::uint32_t kBucketLoad = 4;
+
+// KeyHash splits one 64-bit hash into everything CHD needs for a word
+struct KeyHash {
+  std::uint32_t bucket;
+  std::uint64_t f1;
+  std::uint64_t f2;
+  std::uint8_t fingerprint;
+};
+
+KeyHash SplitHash(std::uint64_t h, std::uint32_t num_buckets, std::uint32_t num_slots) {
+  KeyHash key;
+  key.bucket = static_cast<std::uint32_t>(((h >> 32) * num_buckets) >> 32);
+  key.f1 = MixHash(h ^ 0x9e3779b97f4a7c15ULL) % num_slots;
+  key.f2 = MixHash(h ^ 0xc2b2ae3d27d4eb4fULL) % num_slots;
+  key.fingerprint = static_cast<std::uint8_t>(h);
+  return key;
+}
+
+std::uint32_t NumBuckets(std::uint32_t num_slots) {
+  return std::max<std::uint32_t>(1, (num_slots + kBucketLoad - 1) / kBucketLoad);
+}
+
+// Slot maps a word to its slot given its bucket's displacement index
+std::uint32_t Slot(const KeyHash& key, std::uint32_t displacement, std::uint32_t num_slots) {
+  const std::uint64_t d0 = displacement / num_slots;
+  const std::uint64_t d1 = displacement % num_slots;
+  return static_cast<std::uint32_t>((key.f1 + d0 * key.f2 + d1) % num_slots);
+}
+
+template <typename T>
+void WriteRaw(std::ostream& os, const T& value) {
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+void ReadRaw(std::istream& is, T& value) {
+  is.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+// ReadArray reads count elements into out. The count comes from the file, so out grows a chunk
+// at a time as the data arrives instead of being sized for the claim up front.
+template <typename Container>
+void ReadArray(std::istream& is, std::size_t count, Container& out) {
+  const std::size_t chunk = 1 << 16;
+  out.clear();
+  while (is && out.size() < count) {
+    const auto done = out.size();
+    const auto n = std::min(chunk, count - done);
+    out.resize(done + n);
+    is.read(reinterpret_cast<char*>(&out[done]), n * sizeof(out[0]));
+  }
+}
+
+}  // namespace
+
+PerfectHashLexicon PerfectHashLexicon::Build(const std::unordered_set<std::string>& lexicon) {
+  std::vector<std::vector<const std::string*>> by_length;
+  for (const auto& word : lexicon) {
+    if (word.size() >= by_length.size()) {
+      by_length.resize(word.size() + 1);
+    }
+    by_length[word.size()].push_back(&word);
+  }
+
+  PerfectHashLexicon ret;
+  ret.partitions_.resize(by_length.size());
+  for (std::size_t len = 0; len < by_length.size(); ++len) {
+    if (!by_length[len].empty()) {
+      ret.partitions_[len] = BuildPartition(by_length[len]);
+    }
+  }
+  ret.size_ = lexicon.size();
+  return ret;
+}
+
+PerfectHashLexicon::Partition
+PerfectHashLexicon::BuildPartition(const std::vector<const std::string*>& words) {
+  const auto num_slots = static_cast<std::uint32_t>(words.size());
+  const auto num_buckets = NumBuckets(num_slots);
+  const std::uint64_t max_displacement =
+      std::min<std::uint64_t>(static_cast<std::uint64_t>(num_slots) * num_slots,
+                              std::numeric_limits<std::uint32_t>::max());
+
+  for (std::uint64_t seed = 1;; ++seed) {
+    std::vector<KeyHash> keys;
+    keys.reserve(words.size());
+    std::vector<std::vector<std::uint32_t>> buckets(num_buckets);
+    for (std::uint32_t i = 0; i < num_slots; ++i) {
+      keys.push_back(SplitHash(HashWord(*words[i], seed), num_buckets, num_slots));
+      buckets[keys.back().bucket].push_back(i);
+    }
+
+    // place the biggest buckets first while the table is still empty
+    std::vector<std::uint32_t> order(num_buckets);
+    for (std::uint32_t b = 0; b < num_buckets; ++b) {
+      order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&buckets](std::uint32_t a, std::uint32_t b) {
+      return buckets[a].size() > buckets[b].size();
+    });
+
+    Partition partition;
+    partition.seed = seed;
+    partition.num_slots = num_slots;
+    partition.displacements.assign(num_buckets, 0);
+    std::vector<std::int64_t> owner(num_slots, -1);
+    std::vector<std::uint32_t> slots;
+    bool placed_all = true;
+
+    for (const auto b : order) {
+      const auto& bucket = buckets[b];
+      if (bucket.empty()) {
+        break;
+      }
+      bool placed = false;
+      for (std::uint64_t d = 0; d < max_displacement && !placed; ++d) {
+        slots.clear();
+        placed = true;
+        for (const auto i : bucket) {
+          const auto slot = Slot(keys[i], static_cast<std::uint32_t>(d), num_slots);
+          if (owner[slot] != -1 || std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+            placed = false;
+            break;
+          }
+          slots.push_back(slot);
+        }
+        if (placed) {
+          partition.displacements[b] = static_cast<std::uint32_t>(d);
+          for (std::size_t j = 0; j < bucket.size(); ++j) {
+            owner[slots[j]] = bucket[j];
+          }
+        }
+      }
+      if (!placed) {
+        // two words collide under every displacement, try another seed
+        placed_all = false;
+        break;
+      }
+    }
+    if (!placed_all) {
+      continue;
+    }
+
+    const auto len = words.front()->size();
+    partition.fingerprints.resize(num_slots);
+    partition.keys.resize(static_cast<std::size_t>(num_slots) * len);
+    for (std::uint32_t slot = 0; slot < num_slots; ++slot) {
+      const auto i = static_cast<std::uint32_t>(owner[slot]);
+      partition.fingerprints[slot] = keys[i].fingerprint;
+      partition.keys.replace(slot * len, len, *words[i]);
+    }
+    return partition;
+  }
+}
+
+bool PerfectHashLexicon::Contains(const std::string& word) const noexcept {
+  const auto len = word.size();
+  if (len >= partitions_.size() || partitions_[len].num_slots == 0) {
+    return false;
+  }
+  const auto& partition = partitions_[len];
+  const auto key = SplitHash(HashWord(word, partition.seed), NumBuckets(partition.num_slots),
+                             partition.num_slots);
+  const auto slot = Slot(key, partition.displacements[key.bucket], partition.num_slots);
+  if (partition.fingerprints[slot] != key.fingerprint) {
+    return false;
+  }
+  return partition.keys.compare(slot * len, len, word) == 0;
+}
+
+void PerfectHashLexicon::Save(std::ostream& os) const {
+  os.write(kMagic, sizeof(kMagic));
+  WriteRaw(os, kVersion);
+  WriteRaw(os, static_cast<std::uint64_t>(size_));
+  WriteRaw(os, static_cast<std::uint32_t>(partitions_.size()));
+  for (const auto& partition : partitions_) {
+    WriteRaw(os, partition.seed);
+    WriteRaw(os, partition.num_slots);
+    os.write(reinterpret_cast<const char*>(partition.displacements.data()),
+             partition.displacements.size() * sizeof(std::uint32_t));
+    os.write(reinterpret_cast<const char*>(partition.fingerprints.data()),
+             partition.fingerprints.size());
+    os.write(partition.keys.data(), partition.keys.size());
+  }
+  if (!os) {
+    Error("I/O error while writing perfect hash");
+  }
+}
+
+PerfectHashLexicon PerfectHashLexicon::Load(std::istream& is) {
+  char magic[sizeof(kMagic)];
+  std::uint32_t version = 0;
+  std::uint64_t size = 0;
+  std::uint32_t num_partitions = 0;
+  is.read(magic, sizeof(magic));
+  ReadRaw(is, version);
+  ReadRaw(is, size);
+  ReadRaw(is, num_partitions);
+  if (!is || !std::equal(magic, magic + sizeof(magic), kMagic) || version != kVersion) {
+    Error("Not a perfect hash lexicon file");
+  }
+
+  // an empty lexicon has no partitions, and no partition holds more words than are left over
+  // from the ones before it; partitions are added as they are read, so a header claiming more
+  // than the file holds runs out of file before it can run out of memory
+  if (size == 0 && num_partitions != 0) {
+    Error("Not a perfect hash lexicon file");
+  }
+  PerfectHashLexicon ret;
+  ret.size_ = size;
+  std::uint64_t remaining = size;
+  try {
+    for (std::uint32_t len = 0; len < num_partitions && is; ++len) {
+      auto& partition = ret.partitions_.emplace_back();
+      ReadRaw(is, partition.seed);
+      ReadRaw(is, partition.num_slots);
+      if (!is || partition.num_slots == 0) {
+        continue;
+      }
+      if (partition.num_slots > remaining) {
+        Error("Not a perfect hash lexicon file");
+      }
+      remaining -= partition.num_slots;
+      ReadArray(is, NumBuckets(partition.num_slots), partition.displacements);
+      ReadArray(is, partition.num_slots, partition.fingerprints);
+      ReadArray(is, static_cast<std::size_t>(partition.num_slots) * len, partition.keys);
+    }
+  } catch (const std::bad_alloc&) {
+    Error("Not a perfect hash lexicon file");
+  }
+  if (!is) {
+    Error("I/O error while reading perfect hash");
+  }
+  if (remaining != 0) {
+    Error("Not a perfect hash lexicon file");
+  }
+  return ret;
+}
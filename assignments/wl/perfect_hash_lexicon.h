@@ -0,0 +1,45 @@
+#ifndef ASSIGNMENTS_WL_PERFECT_HASH_LEXICON_H_
+#define ASSIGNMENTS_WL_PERFECT_HASH_LEXICON_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// PerfectHashLexicon is a read-only lexicon built once from GetLexicon's output.
+// Every length partition gets its own minimal perfect hash (CHD: hash, bucket, displace),
+// so a word maps to exactly one slot. Each slot keeps an 8-bit fingerprint that rejects
+// almost every non-member before the stored word is compared.
+class PerfectHashLexicon {
+ public:
+  PerfectHashLexicon() = default;
+
+  static PerfectHashLexicon Build(const std::unordered_set<std::string>& lexicon);
+
+  bool Contains(const std::string& word) const noexcept;
+  std::size_t size() const noexcept { return size_; }
+
+  // Save and Load use a little binary format so the hash can sit next to words.txt
+  void Save(std::ostream& os) const;
+  static PerfectHashLexicon Load(std::istream& is);
+
+ private:
+  // Partition holds every word of one length
+  struct Partition {
+    std::uint64_t seed = 0;
+    std::uint32_t num_slots = 0;
+    std::vector<std::uint32_t> displacements;  // one per bucket
+    std::vector<std::uint8_t> fingerprints;    // one per slot
+    std::string keys;                          // slot i is keys[i * length, (i + 1) * length)
+  };
+
+  static Partition BuildPartition(const std::vector<const std::string*>& words);
+
+  std::vector<Partition> partitions_;  // indexed by word length
+  std::size_t size_ = 0;
+};
+
+#endif  // ASSIGNMENTS_WL_PERFECT_HASH_LEXICON_H_
@@ -0,0 +1,67 @@
+/*
+ * Testing Methodology:
+ * - Every word of the real lexicon must be found, and non-words rejected
+ * - A saved and reloaded hash behaves the same as the one it came from
+ * - WordLadder gives the same answers on either representation
+ */
+#include <sstream>
+#include <string>
+#include <unordered_set>
+
+#include "assignments/wl/lexicon.h"
+#include "assignments/wl/perfect_hash_lexicon.h"
+#include "assignments/wl/word_ladder.h"
+#include "catch.h"
+
+SCENARIO("PerfectHashLexicon answers membership exactly", "[PerfectHashLexicon]") {
+  GIVEN("A small lexicon with words of several lengths") {
+    const std::unordered_set<std::string> lexicon = {"a", "cat", "cot", "dog", "bean", "make"};
+    const auto hashed = PerfectHashLexicon::Build(lexicon);
+
+    THEN("every word is a member") {
+      REQUIRE(hashed.size() == lexicon.size());
+      for (const auto& word : lexicon) {
+        REQUIRE(hashed.Contains(word));
+      }
+    }
+
+    THEN("words outside the lexicon are not") {
+      REQUIRE(!hashed.Contains("cut"));
+      REQUIRE(!hashed.Contains("ab"));
+      REQUIRE(!hashed.Contains("beans"));
+      REQUIRE(!hashed.Contains(""));
+    }
+
+    WHEN("it is saved and loaded again") {
+      std::stringstream buf;
+      hashed.Save(buf);
+      const auto loaded = PerfectHashLexicon::Load(buf);
+
+      THEN("the loaded copy has the same members") {
+        REQUIRE(loaded.size() == hashed.size());
+        for (const auto& word : lexicon) {
+          REQUIRE(loaded.Contains(word));
+        }
+        REQUIRE(!loaded.Contains("cut"));
+      }
+    }
+  }
+
+  GIVEN("The proper lexicon") {
+    const auto lexicon = GetLexicon("data/words.txt");
+    const auto hashed = PerfectHashLexicon::Build(lexicon);
+
+    THEN("every word is found") {
+      std::size_t found = 0;
+      for (const auto& word : lexicon) {
+        found += hashed.Contains(word) ? 1 : 0;
+      }
+      REQUIRE(found == lexicon.size());
+    }
+
+    THEN("neighbours and ladders match the hash set") {
+      REQUIRE(GetNeighbours(hashed, "cat") == GetNeighbours(lexicon, "cat"));
+      REQUIRE(WordLadder(hashed, "bean", "make") == WordLadder(lexicon, "bean", "make"));
+    }
+  }
+}
@@ -0,0 +1,64 @@
+#include "assignments/wl/search_stats.h"
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace {
+
+void WriteLevel(std::ostream& os, const char* kind, const LevelStats& level) {
+  os << "{\"type\":\"" << kind << "\",\"depth\":" << level.depth
+     << ",\"frontier\":" << level.frontier << ",\"expanded\":" << level.expanded
+     << ",\"probes\":" << level.probes << ",\"hits\":" << level.hits
+     << ",\"filtered\":" << level.filtered << ",\"allocations\":" << level.allocations
+     << ",\"ladders_found\":" << level.ladders_found
+     << ",\"elapsed_ms\":" << level.elapsed_ms << "}\n";
+}
+
+}  // namespace
+
+void SearchStats::BeginLevel(std::size_t depth, std::size_t frontier) {
+  CloseLevel();
+  levels_.emplace_back();
+  levels_.back().depth = depth;
+  levels_.back().frontier = frontier;
+  level_start_ = std::chrono::steady_clock::now();
+  ended_ = false;
+}
+
+void SearchStats::EndSearch() {
+  CloseLevel();
+  ended_ = true;
+}
+
+void SearchStats::CloseLevel() {
+  if (levels_.empty() || ended_) {
+    return;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - level_start_;
+  levels_.back().elapsed_ms = std::chrono::duration<double, std::milli>(elapsed).count();
+}
+
+LevelStats SearchStats::Totals() const {
+  LevelStats total;
+  for (const auto& level : levels_) {
+    total.depth = level.depth;
+    total.frontier += level.frontier;
+    total.expanded += level.expanded;
+    total.probes += level.probes;
+    total.hits += level.hits;
+    total.filtered += level.filtered;
+    total.allocations += level.allocations;
+    total.ladders_found += level.ladders_found;
+    total.elapsed_ms += level.elapsed_ms;
+  }
+  return total;
+}
+
+void SearchStats::WriteJsonLines(std::ostream& os) const {
+  for (const auto& level : levels_) {
+    WriteLevel(os, "level", level);
+  }
+  WriteLevel(os, "total", Totals());
+}
@@ -0,0 +1,67 @@
+#ifndef ASSIGNMENTS_WL_SEARCH_STATS_H_
+#define ASSIGNMENTS_WL_SEARCH_STATS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// LevelStats records what the search did while expanding one BFS level
+struct LevelStats {
+  std::size_t depth = 0;          // ladder length at this level
+  std::size_t frontier = 0;       // ladders queued when the level started
+  std::size_t expanded = 0;       // words whose neighbours were generated
+  std::size_t probes = 0;         // candidate lookups against the lexicon
+  std::size_t hits = 0;           // probes that found a word
+  std::size_t filtered = 0;       // probes a prefilter rejected before the lexicon lookup
+  std::size_t allocations = 0;    // ladders and neighbour sets created
+  std::size_t ladders_found = 0;  // complete ladders reaching dest
+  double elapsed_ms = 0;
+};
+
+// NullSearchStats is the default sink. Every hook is an empty inline function so a search
+// instantiated with it compiles down to the uninstrumented BFS.
+class NullSearchStats {
+ public:
+  void BeginLevel(std::size_t, std::size_t) noexcept {}
+  void Expand() noexcept {}
+  void Probe(bool) noexcept {}
+  void Filtered() noexcept {}
+  void Allocation() noexcept {}
+  void LadderFound() noexcept {}
+  void EndSearch() noexcept {}
+};
+
+// SearchStats collects per-level counters and timings for a single WordLadder query.
+// The search calls BeginLevel before any other hook.
+class SearchStats {
+ public:
+  void BeginLevel(std::size_t depth, std::size_t frontier);
+  void Expand() noexcept { ++Current().expanded; }
+  void Probe(bool hit) noexcept {
+    ++Current().probes;
+    if (hit) {
+      ++Current().hits;
+    }
+  }
+  void Filtered() noexcept { ++Current().filtered; }
+  void Allocation() noexcept { ++Current().allocations; }
+  void LadderFound() noexcept { ++Current().ladders_found; }
+  void EndSearch();
+
+  const std::vector<LevelStats>& Levels() const noexcept { return levels_; }
+  LevelStats Totals() const;
+
+  // WriteJsonLines writes one JSON object per level followed by a summary line
+  void WriteJsonLines(std::ostream& os) const;
+
+ private:
+  LevelStats& Current() noexcept { return levels_.back(); }
+  void CloseLevel();
+
+  std::vector<LevelStats> levels_;
+  std::chrono::steady_clock::time_point level_start_;
+  bool ended_ = false;
+};
+
+#endif  // ASSIGNMENTS_WL_SEARCH_STATS_H_
@@ -0,0 +1,105 @@
+#include "assignments/wl/word_graph.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+WordGraph::WordGraph(const std::unordered_set<std::string>& lexicon)
+  : words_(lexicon.begin(), lexicon.end()) {
+  std::sort(words_.begin(), words_.end(), [](const std::string& a, const std::string& b) {
+    return a.size() != b.size() ? a.size() < b.size() : a < b;
+  });
+  ids_.reserve(words_.size());
+  for (WordId id = 0; id < words_.size(); ++id) {
+    ids_.emplace(words_[id], id);
+  }
+
+  // words one substitution apart become equal once the differing position is blanked out, so
+  // sorting each partition by its blanked form at every position puts neighbours side by side
+  std::vector<std::pair<WordId, WordId>> edges;
+  std::vector<std::pair<std::string, WordId>> blanked;
+  for (std::size_t length = 1; !words_.empty() && length <= words_.back().size(); ++length) {
+    const auto range = Partition(length);
+    for (std::size_t i = 0; i < length; ++i) {
+      blanked.clear();
+      for (auto id = range.first; id < range.second; ++id) {
+        auto key = words_[id];
+        key[i] = '\0';
+        blanked.emplace_back(std::move(key), id);
+      }
+      std::sort(blanked.begin(), blanked.end());
+      for (std::size_t group = 0; group < blanked.size();) {
+        auto end = group + 1;
+        while (end < blanked.size() && blanked[end].first == blanked[group].first) {
+          ++end;
+        }
+        for (auto a = group; a < end; ++a) {
+          for (auto b = a + 1; b < end; ++b) {
+            edges.emplace_back(blanked[a].second, blanked[b].second);
+            edges.emplace_back(blanked[b].second, blanked[a].second);
+          }
+        }
+        group = end;
+      }
+    }
+  }
+
+  std::sort(edges.begin(), edges.end());
+  offsets_.assign(words_.size() + 1, 0);
+  adjacency_.reserve(edges.size());
+  for (const auto& edge : edges) {
+    ++offsets_[edge.first + 1];
+    adjacency_.push_back(edge.second);
+  }
+  for (std::size_t i = 1; i < offsets_.size(); ++i) {
+    offsets_[i] += offsets_[i - 1];
+  }
+}
+
+WordId WordGraph::Find(const std::string& word) const {
+  const auto it = ids_.find(word);
+  return it == ids_.end() ? kNoWord : it->second;
+}
+
+std::pair<WordId, WordId> WordGraph::Partition(std::size_t length) const noexcept {
+  const auto by_length = [](const std::string& word, std::size_t len) { return word.size() < len; };
+  const auto first = std::lower_bound(words_.begin(), words_.end(), length, by_length);
+  const auto last = std::lower_bound(first, words_.end(), length + 1, by_length);
+  return {static_cast<WordId>(first - words_.begin()), static_cast<WordId>(last - words_.begin())};
+}
+
+WordMask WordGraph::MaskOf(const std::vector<std::string>& words) const {
+  WordMask mask(size());
+  for (const auto& word : words) {
+    const auto id = Find(word);
+    if (id != kNoWord) {
+      mask.Set(id);
+    }
+  }
+  return mask;
+}
+
+std::vector<std::uint32_t>
+Distances(const WordGraph& graph, WordId source, std::uint32_t max_depth) {
+  std::vector<std::uint32_t> dist(graph.size(), kUnreachable);
+  dist[source] = 0;
+  std::vector<WordId> frontier = {source};
+  std::vector<WordId> next;
+  for (std::uint32_t depth = 1; !frontier.empty() && depth <= max_depth; ++depth) {
+    next.clear();
+    for (const auto word : frontier) {
+      for (const auto neighbour : graph.Adjacent(word)) {
+        if (dist[neighbour] == kUnreachable) {
+          dist[neighbour] = depth;
+          next.push_back(neighbour);
+        }
+      }
+    }
+    frontier.swap(next);
+  }
+  return dist;
+}
@@ -0,0 +1,76 @@
+#ifndef ASSIGNMENTS_WL_WORD_GRAPH_H_
+#define ASSIGNMENTS_WL_WORD_GRAPH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+using WordId = std::uint32_t;
+const WordId kNoWord = static_cast<WordId>(-1);
+
+// WordMask is a bitset over the word ids of a WordGraph
+class WordMask {
+ public:
+  WordMask() = default;
+  explicit WordMask(std::size_t size) : bits_((size + 63) / 64, 0), size_(size) {}
+
+  void Set(WordId id) noexcept { bits_[id / 64] |= std::uint64_t{1} << (id % 64); }
+  void Reset(WordId id) noexcept { bits_[id / 64] &= ~(std::uint64_t{1} << (id % 64)); }
+  bool Test(WordId id) const noexcept { return (bits_[id / 64] >> (id % 64)) & 1; }
+  std::size_t size() const noexcept { return size_; }
+
+ private:
+  std::vector<std::uint64_t> bits_;
+  std::size_t size_ = 0;
+};
+
+// WordGraph gives every word of a lexicon an id and stores, in compressed sparse row form, the
+// ids of the words one substitution away from it. Ids are assigned in (length, word) order, so
+// every length partition is a contiguous id range.
+class WordGraph {
+ public:
+  explicit WordGraph(const std::unordered_set<std::string>& lexicon);
+
+  // Neighbours is the sorted adjacency list of one word
+  struct Neighbours {
+    const WordId* begin() const noexcept { return first; }
+    const WordId* end() const noexcept { return last; }
+    std::size_t size() const noexcept { return static_cast<std::size_t>(last - first); }
+
+    const WordId* first;
+    const WordId* last;
+  };
+
+  Neighbours Adjacent(WordId id) const noexcept {
+    return {adjacency_.data() + offsets_[id], adjacency_.data() + offsets_[id + 1]};
+  }
+  WordId Find(const std::string& word) const;
+  const std::string& Word(WordId id) const noexcept { return words_[id]; }
+
+  // Partition returns the [first, last) id range of the words of length
+  std::pair<WordId, WordId> Partition(std::size_t length) const noexcept;
+
+  // MaskOf returns a mask with the ids of words set; words not in the graph are ignored
+  WordMask MaskOf(const std::vector<std::string>& words) const;
+
+  std::size_t size() const noexcept { return words_.size(); }
+  std::size_t NumEdges() const noexcept { return adjacency_.size() / 2; }
+
+ private:
+  std::vector<std::string> words_;
+  std::unordered_map<std::string, WordId> ids_;
+  std::vector<std::size_t> offsets_;  // word i owns adjacency_[offsets_[i], offsets_[i + 1])
+  std::vector<WordId> adjacency_;
+};
+
+// Distances returns the BFS distance of every word from source, stopping after max_depth steps.
+// Words further away or unreachable are left at kUnreachable.
+const std::uint32_t kUnreachable = static_cast<std::uint32_t>(-1);
+std::vector<std::uint32_t>
+Distances(const WordGraph& graph, WordId source, std::uint32_t max_depth = kUnreachable);
+
+#endif  // ASSIGNMENTS_WL_WORD_GRAPH_H_
@@ -0,0 +1,27 @@
+#ifndef ASSIGNMENTS_WL_WORD_HASH_H_
+#define ASSIGNMENTS_WL_WORD_HASH_H_
+
+#include <cstdint>
+#include <string>
+
+// MixHash is the splitmix64 finaliser, used to spread bits before they are split up
+inline std::uint64_t MixHash(std::uint64_t h) noexcept {
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return h;
+}
+
+// HashWord is a seeded FNV-1a hash of word, mixed so every output bit is usable
+inline std::uint64_t HashWord(const std::string& word, std::uint64_t seed = 0) noexcept {
+  std::uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+  for (const auto ch : word) {
+    h ^= static_cast<unsigned char>(ch);
+    h *= 0x100000001b3ULL;
+  }
+  return MixHash(h);
+}
+
+#endif  // ASSIGNMENTS_WL_WORD_HASH_H_
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <cstdint>
 #include <deque>
 #include <iterator>
 #include <set>
@@ -8,36 +9,185 @@
 
 #include <iostream>
 
+#include "assignments/wl/alphabet.h"
+#include "assignments/wl/bloom_filter.h"
+#include "assignments/wl/dawg.h"
+#include "assignments/wl/ladder_options.h"
+#include "assignments/wl/packed_lexicon.h"
+#include "assignments/wl/perfect_hash_lexicon.h"
+#include "assignments/wl/search_stats.h"
 #include "assignments/wl/word_ladder.h"
 
-#define ALPHA_LEN 26
+namespace {
 
-// GetNeighbours returns set of neighbours of str in the lexicon
-const std::set<std::string> GetNeighbours(const std::unordered_set<std::string>& lexicon,
-                                          const std::string& str) {
+// Prefiltered pairs a lexicon with a filter that is asked first
+template <typename Lexicon>
+struct Prefiltered {
+  const Lexicon& lexicon;
+  const LexiconFilter& filter;
+};
+
+// WithAlphabet pairs a lexicon with the alphabet its candidates are drawn from
+template <typename Lexicon>
+struct WithAlphabet {
+  const Lexicon& lexicon;
+  const Alphabet& alphabet;
+};
+
+// InLexicon is the membership probe for each lexicon representation
+template <typename Stats>
+bool InLexicon(const std::unordered_set<std::string>& lexicon,
+               const std::string& word,
+               Stats& stats) {
+  const bool hit = lexicon.find(word) != lexicon.end();
+  stats.Probe(hit);
+  return hit;
+}
+
+template <typename Stats>
+bool InLexicon(const PerfectHashLexicon& lexicon, const std::string& word, Stats& stats) {
+  const bool hit = lexicon.Contains(word);
+  stats.Probe(hit);
+  return hit;
+}
+
+template <typename Stats>
+bool InLexicon(const PackedLexicon& lexicon, const std::string& word, Stats& stats) {
+  const bool hit = lexicon.Contains(word);
+  stats.Probe(hit);
+  return hit;
+}
+
+template <typename Lexicon, typename Stats>
+bool InLexicon(const Prefiltered<Lexicon>& lexicon, const std::string& word, Stats& stats) {
+  if (!lexicon.filter.MayContain(word)) {
+    stats.Filtered();
+    return false;
+  }
+  return InLexicon(lexicon.lexicon, word, stats);
+}
+
+// ProbeNeighbours tries every letter alphabet allows at each position of str and probes the
+// lexicon for the result
+template <typename Lexicon, typename Stats>
+std::set<std::string> ProbeNeighbours(const Lexicon& lexicon,
+                                      const Alphabet& alphabet,
+                                      const std::string& str,
+                                      Stats& stats) {
   std::set<std::string> neighbours;
+  stats.Allocation();
+  auto next = str;
   for (std::string::size_type i = 0; i < str.size(); ++i) {
-    for (int offset = 1; offset < ALPHA_LEN; ++offset) {
-      // copy string
-      auto next = str;
-      // offset index
-      int ch = next[i] + offset;
-      next[i] = (ch <= 'z') ? ch : (ch % 'z') + ('a' - 1);
+    for (const auto ch : alphabet.Letters(str.size(), i)) {
+      if (ch == str[i]) {
+        continue;
+      }
+      next[i] = ch;
       // search lexicon
-      if (lexicon.find(next) != lexicon.end()) {
+      if (InLexicon(lexicon, next, stats)) {
         // append candidate
         neighbours.insert(next);
       }
     }
+    next[i] = str[i];
   }
   return neighbours;
 }
 
-// WordLadder returns the word ladder(s) from the start to dest words in the lexicon
-// assume input generates valid ladder(s)
-const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
-                                                    const std::string& start,
-                                                    const std::string& dest) {
+// CollectNeighbours is GetNeighbours with a stats sink that sees every lexicon probe
+template <typename Lexicon, typename Stats>
+std::set<std::string> CollectNeighbours(const Lexicon& lexicon,
+                                        const std::string& str,
+                                        Stats& stats) {
+  return ProbeNeighbours(lexicon, Alphabet::Lowercase(), str, stats);
+}
+
+// CollectNeighbours for a lexicon with its own alphabet
+template <typename Lexicon, typename Stats>
+std::set<std::string> CollectNeighbours(const WithAlphabet<Lexicon>& lexicon,
+                                        const std::string& str,
+                                        Stats& stats) {
+  return ProbeNeighbours(lexicon.lexicon, lexicon.alphabet, str, stats);
+}
+
+// CollectNeighbours for a PackedLexicon swaps 5-bit fields of the packed key, falling back to
+// string candidates for words that don't pack
+template <typename Stats>
+std::set<std::string> CollectNeighbours(const PackedLexicon& lexicon,
+                                        const std::string& str,
+                                        Stats& stats) {
+  std::uint64_t key;
+  if (!PackWord(str, key)) {
+    return ProbeNeighbours(lexicon, Alphabet::Lowercase(), str, stats);
+  }
+  std::set<std::string> neighbours;
+  stats.Allocation();
+  lexicon.ForEachNeighbour(key, [&neighbours](std::uint64_t next) {
+    neighbours.insert(UnpackWord(next));
+  });
+  return neighbours;
+}
+
+// CollectNeighbours for a Dawg walks the graph instead of probing candidates
+template <typename Stats>
+std::set<std::string> CollectNeighbours(const Dawg& lexicon, const std::string& str, Stats& stats) {
+  std::set<std::string> neighbours;
+  stats.Allocation();
+  lexicon.ForEachNeighbour(str, [&neighbours](const std::string& next) {
+    neighbours.insert(neighbours.end(), next);
+  });
+  return neighbours;
+}
+
+// Unlimited is the guard for searches without options, it never stops them
+struct Unlimited {
+  bool ShouldStop(std::size_t) noexcept { return false; }
+  bool ShouldStopAtLevel(std::size_t) noexcept { return false; }
+};
+
+// Limited enforces LadderOptions on a search and remembers why it stopped it
+class Limited {
+ public:
+  explicit Limited(const LadderOptions& options) : options_(options) {}
+
+  // ShouldStop is asked before each expansion, with the number done so far
+  bool ShouldStop(std::size_t expanded) noexcept {
+    if (expanded >= options_.max_nodes) {
+      status_ = LadderStatus::kNodeBudgetExceeded;
+      return true;
+    }
+    return expanded % kCheckInterval == 0 && ShouldStopAtLevel(expanded);
+  }
+
+  // ShouldStopAtLevel is asked at every level boundary
+  bool ShouldStopAtLevel(std::size_t) noexcept {
+    if (options_.cancel != nullptr && options_.cancel->IsCancelled()) {
+      status_ = LadderStatus::kCancelled;
+    } else if (options_.deadline != std::chrono::steady_clock::time_point::max() &&
+               std::chrono::steady_clock::now() >= options_.deadline) {
+      status_ = LadderStatus::kTimedOut;
+    }
+    return status_ != LadderStatus::kComplete;
+  }
+
+  LadderStatus status() const noexcept { return status_; }
+
+ private:
+  // expansions between clock and token checks inside a level
+  static const std::size_t kCheckInterval = 256;
+
+  const LadderOptions& options_;
+  LadderStatus status_ = LadderStatus::kComplete;
+};
+
+// Search is the BFS behind WordLadder, reporting its progress to stats and asking guard
+// whether to carry on
+template <typename Lexicon, typename Stats, typename Guard>
+std::set<std::vector<std::string>> Search(const Lexicon& lexicon,
+                                          const std::string& start,
+                                          const std::string& dest,
+                                          Stats& stats,
+                                          Guard& guard) {
   // ladders is our queue of string vectors
   std::deque<std::vector<std::string>> ladders;
   std::set<std::vector<std::string>> output;
@@ -45,6 +195,8 @@ const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std
   // put a starting ladder into our deque
   std::vector<std::string> begin = {start};
   ladders.push_back(begin);
+  stats.BeginLevel(begin.size(), ladders.size());
+  stats.Allocation();
 
   // seen bookeeping
   std::vector<std::string>::size_type curr_size = begin.size();
@@ -54,6 +206,7 @@ const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std
 
   // same-length path bookeeping
   bool ret_flag = false;
+  std::size_t expanded = 0;
 
   // BFS
   for (auto curr_ladder = ladders.front(); !ladders.empty(); ladders.pop_front()) {
@@ -64,10 +217,16 @@ const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std
     if (curr_ladder.size() != curr_size) {
       if (ret_flag) {
         // hit a longer ladder, return
+        stats.EndSearch();
         return output;
       } else {
         seen.insert(cache.begin(), cache.end());
         curr_size = curr_ladder.size();
+        stats.BeginLevel(curr_size, ladders.size());
+        if (guard.ShouldStopAtLevel(expanded)) {
+          stats.EndSearch();
+          return output;
+        }
       }
     }
 
@@ -83,9 +242,14 @@ const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std
       }
       // add ladder to output
       output.insert(curr_ladder);
+      stats.LadderFound();
     } else {
       // create new ladders and push onto deque
-      const auto neighbours = GetNeighbours(lexicon, curr_word);
+      if (guard.ShouldStop(expanded++)) {
+        break;
+      }
+      stats.Expand();
+      const auto neighbours = CollectNeighbours(lexicon, curr_word, stats);
       for (const auto& neighbour : neighbours) {
         // avoid adding seen words
         if (seen.find(neighbour) == seen.end()) {
@@ -93,10 +257,209 @@ const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std
           std::vector<std::string> new_ladder = curr_ladder;
           new_ladder.push_back(new_word);
           ladders.push_back(new_ladder);
+          stats.Allocation();
           cache.insert(neighbour);
         }
       }
     }
   }
+  stats.EndSearch();
   return output;
 }
+
+template <typename Lexicon, typename Stats>
+std::set<std::vector<std::string>> Search(const Lexicon& lexicon,
+                                          const std::string& start,
+                                          const std::string& dest,
+                                          Stats& stats) {
+  Unlimited guard;
+  return Search(lexicon, start, dest, stats, guard);
+}
+
+// BoundedSearch runs Search under options and reports whether it finished
+template <typename Lexicon>
+LadderResult BoundedSearch(const Lexicon& lexicon,
+                           const std::string& start,
+                           const std::string& dest,
+                           const LadderOptions& options) {
+  NullSearchStats stats;
+  Limited guard(options);
+  LadderResult result;
+  result.ladders = Search(lexicon, start, dest, stats, guard);
+  result.status = guard.status();
+  return result;
+}
+
+}  // namespace
+
+// GetNeighbours returns set of neighbours of str in the lexicon
+const std::set<std::string> GetNeighbours(const std::unordered_set<std::string>& lexicon,
+                                          const std::string& str) {
+  NullSearchStats stats;
+  return CollectNeighbours(lexicon, str, stats);
+}
+
+// WordLadder returns the word ladder(s) from the start to dest words in the lexicon
+// assume input generates valid ladder(s)
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest) {
+  NullSearchStats stats;
+  return Search(lexicon, start, dest, stats);
+}
+
+// WordLadder overload that records what the search did into stats
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats) {
+  return Search(lexicon, start, dest, stats);
+}
+
+// GetNeighbours overload probing the perfect hash instead of the hash set
+const std::set<std::string> GetNeighbours(const PerfectHashLexicon& lexicon,
+                                          const std::string& str) {
+  NullSearchStats stats;
+  return CollectNeighbours(lexicon, str, stats);
+}
+
+// WordLadder overloads searching the perfect hash instead of the hash set
+const std::set<std::vector<std::string>> WordLadder(const PerfectHashLexicon& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest) {
+  NullSearchStats stats;
+  return Search(lexicon, start, dest, stats);
+}
+
+const std::set<std::vector<std::string>> WordLadder(const PerfectHashLexicon& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats) {
+  return Search(lexicon, start, dest, stats);
+}
+
+// GetNeighbours overload drawing candidates from alphabet instead of 'a'..'z'
+const std::set<std::string> GetNeighbours(const std::unordered_set<std::string>& lexicon,
+                                          const Alphabet& alphabet,
+                                          const std::string& str) {
+  NullSearchStats stats;
+  return ProbeNeighbours(lexicon, alphabet, str, stats);
+}
+
+// WordLadder overloads drawing candidates from alphabet instead of 'a'..'z'
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const Alphabet& alphabet,
+                                                    const std::string& start,
+                                                    const std::string& dest) {
+  NullSearchStats stats;
+  return Search(WithAlphabet<std::unordered_set<std::string>>{lexicon, alphabet}, start, dest,
+                stats);
+}
+
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const Alphabet& alphabet,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats) {
+  return Search(WithAlphabet<std::unordered_set<std::string>>{lexicon, alphabet}, start, dest,
+                stats);
+}
+
+// GetNeighbours overload that asks filter before probing the lexicon
+const std::set<std::string> GetNeighbours(const std::unordered_set<std::string>& lexicon,
+                                          const LexiconFilter& filter,
+                                          const std::string& str) {
+  NullSearchStats stats;
+  return CollectNeighbours(Prefiltered<std::unordered_set<std::string>>{lexicon, filter}, str,
+                           stats);
+}
+
+// WordLadder overloads that ask filter before probing the lexicon
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const LexiconFilter& filter,
+                                                    const std::string& start,
+                                                    const std::string& dest) {
+  NullSearchStats stats;
+  return Search(Prefiltered<std::unordered_set<std::string>>{lexicon, filter}, start, dest,
+                stats);
+}
+
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const LexiconFilter& filter,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats) {
+  return Search(Prefiltered<std::unordered_set<std::string>>{lexicon, filter}, start, dest,
+                stats);
+}
+
+// GetNeighbours overload enumerating neighbours straight from a Dawg
+const std::set<std::string> GetNeighbours(const Dawg& lexicon, const std::string& str) {
+  NullSearchStats stats;
+  return CollectNeighbours(lexicon, str, stats);
+}
+
+// WordLadder overloads searching a Dawg
+const std::set<std::vector<std::string>> WordLadder(const Dawg& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest) {
+  NullSearchStats stats;
+  return Search(lexicon, start, dest, stats);
+}
+
+const std::set<std::vector<std::string>> WordLadder(const Dawg& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats) {
+  return Search(lexicon, start, dest, stats);
+}
+
+// GetNeighbours overload using packed integer keys
+const std::set<std::string> GetNeighbours(const PackedLexicon& lexicon, const std::string& str) {
+  NullSearchStats stats;
+  return CollectNeighbours(lexicon, str, stats);
+}
+
+// WordLadder overloads searching a PackedLexicon
+const std::set<std::vector<std::string>> WordLadder(const PackedLexicon& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest) {
+  NullSearchStats stats;
+  return Search(lexicon, start, dest, stats);
+}
+
+const std::set<std::vector<std::string>> WordLadder(const PackedLexicon& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats) {
+  return Search(lexicon, start, dest, stats);
+}
+
+// WordLadder overloads bounded by a deadline, node budget and cancellation token
+LadderResult WordLadder(const std::unordered_set<std::string>& lexicon,
+                        const std::string& start,
+                        const std::string& dest,
+                        const LadderOptions& options) {
+  return BoundedSearch(lexicon, start, dest, options);
+}
+
+LadderResult WordLadder(const PerfectHashLexicon& lexicon,
+                        const std::string& start,
+                        const std::string& dest,
+                        const LadderOptions& options) {
+  return BoundedSearch(lexicon, start, dest, options);
+}
+
+LadderResult WordLadder(const Dawg& lexicon,
+                        const std::string& start,
+                        const std::string& dest,
+                        const LadderOptions& options) {
+  return BoundedSearch(lexicon, start, dest, options);
+}
+
+LadderResult WordLadder(const PackedLexicon& lexicon,
+                        const std::string& start,
+                        const std::string& dest,
+                        const LadderOptions& options) {
+  return BoundedSearch(lexicon, start, dest, options);
+}
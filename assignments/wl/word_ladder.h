@@ -6,6 +6,14 @@
 #include <unordered_set>
 #include <vector>
 
+#include "assignments/wl/alphabet.h"
+#include "assignments/wl/bloom_filter.h"
+#include "assignments/wl/dawg.h"
+#include "assignments/wl/ladder_options.h"
+#include "assignments/wl/packed_lexicon.h"
+#include "assignments/wl/perfect_hash_lexicon.h"
+#include "assignments/wl/search_stats.h"
+
 const std::set<std::string> GetNeighbours(const std::unordered_set<std::string>& lexicon,
                                           const std::string& str);
 
@@ -14,4 +22,94 @@ WordLadder(const std::unordered_set<std::string>& lexicon,
                                                     const std::string& start,
                                                     const std::string& dest);
 
+const std::set<std::vector<std::string>>
+WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats);
+
+const std::set<std::string> GetNeighbours(const PerfectHashLexicon& lexicon,
+                                          const std::string& str);
+
+const std::set<std::vector<std::string>> WordLadder(const PerfectHashLexicon& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest);
+
+const std::set<std::vector<std::string>> WordLadder(const PerfectHashLexicon& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats);
+
+const std::set<std::string> GetNeighbours(const std::unordered_set<std::string>& lexicon,
+                                          const Alphabet& alphabet,
+                                          const std::string& str);
+
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const Alphabet& alphabet,
+                                                    const std::string& start,
+                                                    const std::string& dest);
+
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const Alphabet& alphabet,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats);
+
+const std::set<std::string> GetNeighbours(const std::unordered_set<std::string>& lexicon,
+                                          const LexiconFilter& filter,
+                                          const std::string& str);
+
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const LexiconFilter& filter,
+                                                    const std::string& start,
+                                                    const std::string& dest);
+
+const std::set<std::vector<std::string>> WordLadder(const std::unordered_set<std::string>& lexicon,
+                                                    const LexiconFilter& filter,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats);
+
+const std::set<std::string> GetNeighbours(const Dawg& lexicon, const std::string& str);
+
+const std::set<std::vector<std::string>> WordLadder(const Dawg& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest);
+
+const std::set<std::vector<std::string>> WordLadder(const Dawg& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats);
+
+const std::set<std::string> GetNeighbours(const PackedLexicon& lexicon, const std::string& str);
+
+const std::set<std::vector<std::string>> WordLadder(const PackedLexicon& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest);
+
+const std::set<std::vector<std::string>> WordLadder(const PackedLexicon& lexicon,
+                                                    const std::string& start,
+                                                    const std::string& dest,
+                                                    SearchStats& stats);
+
+LadderResult WordLadder(const std::unordered_set<std::string>& lexicon,
+                        const std::string& start,
+                        const std::string& dest,
+                        const LadderOptions& options);
+
+LadderResult WordLadder(const PerfectHashLexicon& lexicon,
+                        const std::string& start,
+                        const std::string& dest,
+                        const LadderOptions& options);
+
+LadderResult WordLadder(const Dawg& lexicon,
+                        const std::string& start,
+                        const std::string& dest,
+                        const LadderOptions& options);
+
+LadderResult WordLadder(const PackedLexicon& lexicon,
+                        const std::string& start,
+                        const std::string& dest,
+                        const LadderOptions& options);
+
 #endif  // ASSIGNMENTS_WL_WORD_LADDER_H_
@@ -5,6 +5,10 @@
  *  - Get coverage
  *  - Test intended behaviour
  */
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
 #include "assignments/wl/lexicon.h"
 #include "assignments/wl/word_ladder.h"
 #include "catch.h"
@@ -108,3 +112,112 @@ SCENARIO("WordLadder works correctly", "[WordLadder]") {
     }
   }
 }
+
+SCENARIO("WordLadder reports search statistics", "[WordLadder][SearchStats]") {
+  GIVEN("The proper lexicon and a stats sink") {
+    auto lexicon = GetLexicon("data/words.txt");
+    SearchStats stats;
+
+    WHEN("con -> cat is searched with stats") {
+      auto got = WordLadder(lexicon, static_cast<std::string>("con"),
+                            static_cast<std::string>("cat"), stats);
+
+      THEN("the ladders match the uninstrumented search") {
+        REQUIRE(got == WordLadder(lexicon, static_cast<std::string>("con"),
+                                  static_cast<std::string>("cat")));
+      }
+
+      THEN("every level is recorded and the totals add up") {
+        const auto total = stats.Totals();
+        REQUIRE(stats.Levels().size() == 3);
+        REQUIRE(stats.Levels().front().frontier == 1);
+        REQUIRE(total.ladders_found == got.size());
+        REQUIRE(total.probes == total.expanded * 25 * 3);
+        REQUIRE(total.hits <= total.probes);
+      }
+
+      THEN("the stats export as one JSON line per level plus a total") {
+        std::ostringstream os;
+        stats.WriteJsonLines(os);
+        const auto out = os.str();
+        REQUIRE(std::count(out.begin(), out.end(), '\n') == 4);
+        REQUIRE(out.find("{\"type\":\"total\"") != std::string::npos);
+      }
+    }
+  }
+}
+
+SCENARIO("WordLadder honours LadderOptions", "[WordLadder][LadderOptions]") {
+  GIVEN("The proper lexicon") {
+    auto lexicon = GetLexicon("data/words.txt");
+    LadderOptions options;
+
+    WHEN("no limits are set") {
+      auto got = WordLadder(lexicon, "bean", "make", options);
+      THEN("the search completes with every shortest ladder") {
+        REQUIRE(got.complete());
+        REQUIRE(got.ladders == WordLadder(lexicon, "bean", "make"));
+      }
+    }
+
+    WHEN("the node budget is tiny") {
+      options.max_nodes = 10;
+      auto got = WordLadder(lexicon, "bean", "make", options);
+      THEN("the search stops and says so") {
+        REQUIRE(got.status == LadderStatus::kNodeBudgetExceeded);
+        REQUIRE(got.ladders.empty());
+      }
+    }
+
+    WHEN("the deadline has already passed") {
+      options.deadline = std::chrono::steady_clock::now();
+      auto got = WordLadder(lexicon, "bean", "make", options);
+      THEN("the search reports a timeout") { REQUIRE(got.status == LadderStatus::kTimedOut); }
+    }
+
+    WHEN("the query has been cancelled") {
+      CancellationToken token;
+      token.Cancel();
+      options.cancel = &token;
+      auto got = WordLadder(lexicon, "bean", "make", options);
+      THEN("the search reports cancellation") { REQUIRE(got.status == LadderStatus::kCancelled); }
+    }
+  }
+}
+
+SCENARIO("Neighbours are drawn from the lexicon's own alphabet", "[GetNeighbours][Alphabet]") {
+  GIVEN("A lexicon using digits and uppercase letters") {
+    auto lexicon = std::unordered_set<std::string>{
+        static_cast<std::string>("A1"), static_cast<std::string>("A2"),
+        static_cast<std::string>("B2"), static_cast<std::string>("B3")};
+    const auto alphabet = Alphabet::FromLexicon(lexicon);
+
+    THEN("only letters seen at each position are tried") {
+      REQUIRE(alphabet.Letters(2, 0) == "AB");
+      REQUIRE(alphabet.Letters(2, 1) == "123");
+      REQUIRE(alphabet.Letters(3, 0).empty());
+    }
+
+    THEN("ladders can be found through non-lowercase words") {
+      auto got = WordLadder(lexicon, alphabet, static_cast<std::string>("A1"),
+                            static_cast<std::string>("B3"));
+      REQUIRE(got == std::set<std::vector<std::string>>{{"A1", "A2", "B2", "B3"}});
+    }
+  }
+
+  GIVEN("The proper lexicon and its alphabet") {
+    auto lexicon = GetLexicon("data/words.txt");
+    const auto alphabet = Alphabet::FromLexicon(lexicon);
+
+    THEN("the ladders are unchanged but fewer candidates are probed") {
+      SearchStats lowercase;
+      SearchStats pruned;
+      auto expected = WordLadder(lexicon, static_cast<std::string>("awake"),
+                                 static_cast<std::string>("sleep"), lowercase);
+      auto got = WordLadder(lexicon, alphabet, static_cast<std::string>("awake"),
+                            static_cast<std::string>("sleep"), pruned);
+      REQUIRE(got == expected);
+      REQUIRE(pruned.Totals().probes < lowercase.Totals().probes);
+    }
+  }
+}